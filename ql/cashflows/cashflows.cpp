@@ -22,6 +22,7 @@
 
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/coupon.hpp>
+#include <ql/cashflows/compactleg.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
@@ -1274,4 +1275,90 @@ namespace QuantLib {
         return solver.solve(objFunction, accuracy, guess, step);
     }
 
+
+    // CompactLeg functions
+
+    Date CashFlows::startDate(const CompactLeg& leg) {
+        QL_REQUIRE(!leg.empty(), "empty leg");
+        return leg.accrualStartDates().front();
+    }
+
+    Date CashFlows::maturityDate(const CompactLeg& leg) {
+        QL_REQUIRE(!leg.empty(), "empty leg");
+        return leg.accrualEndDates().back();
+    }
+
+    Real CashFlows::accruedAmount(const CompactLeg& leg,
+                                  bool includeSettlementDateFlows,
+                                  Date settlementDate) {
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        Size n = leg.size(), i = 0;
+        while (i < n && leg.hasOccurred(i, settlementDate,
+                                        includeSettlementDateFlows))
+            ++i;
+        if (i == n) return 0.0;
+
+        const std::vector<Date>& paymentDates = leg.paymentDates();
+        Date paymentDate = paymentDates[i];
+        Real result = 0.0;
+        for (; i<n && paymentDates[i]==paymentDate; ++i)
+            result += leg.accruedAmount(i, settlementDate);
+        return result;
+    }
+
+    Real CashFlows::npv(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        const std::vector<Date>& paymentDates = leg.paymentDates();
+        Real totalNPV = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate,
+                                 includeSettlementDateFlows))
+                totalNPV += leg.amount(i) *
+                            discountCurve.discount(paymentDates[i]);
+        }
+
+        return totalNPV/discountCurve.discount(npvDate);
+    }
+
+    Real CashFlows::bps(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        const std::vector<Date>& paymentDates = leg.paymentDates();
+        const std::vector<Real>& nominals = leg.nominals();
+        Real bps = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate,
+                                 includeSettlementDateFlows))
+                bps += nominals[i] * leg.accrualPeriod(i) *
+                       discountCurve.discount(paymentDates[i]);
+        }
+        return basisPoint_*bps/discountCurve.discount(npvDate);
+    }
+
 }
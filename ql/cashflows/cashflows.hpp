@@ -35,6 +35,7 @@
 namespace QuantLib {
 
     class YieldTermStructure;
+    class CompactLeg;
 
     //! %cashflow-analysis functions
     /*! \todo add tests */
@@ -443,6 +444,31 @@ namespace QuantLib {
         }
         //@}
 
+        //! \name CompactLeg functions
+        /*! These work directly on the columns of the leg, without
+            creating the corresponding coupons; the results are the
+            same as for the Leg returned by CompactLeg::toLeg().
+        */
+        //@{
+        static Date startDate(const CompactLeg& leg);
+        static Date maturityDate(const CompactLeg& leg);
+        static Real accruedAmount(const CompactLeg& leg,
+                                  bool includeSettlementDateFlows,
+                                  Date settlementDate = Date());
+        //! NPV of the cash flows.
+        static Real npv(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        //! Basis-point sensitivity of the cash flows.
+        static Real bps(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        //@}
+
     };
 
 }
@@ -0,0 +1,324 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compactleg.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/indexes/iborindex.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/settings.hpp>
+#include <ql/utilities/vectors.hpp>
+
+namespace QuantLib {
+
+    CompactLeg::CompactLeg(const Schedule& schedule,
+                           const std::vector<Real>& nominals,
+                           const std::vector<Rate>& couponRates,
+                           const DayCounter& dayCounter,
+                           Compounding compounding,
+                           Frequency frequency,
+                           BusinessDayConvention paymentAdjustment,
+                           Natural paymentLag,
+                           const Calendar& paymentCalendar)
+    : dayCounter_(dayCounter), compounding_(compounding),
+      frequency_(frequency), fixingDays_(0) {
+
+        QL_REQUIRE(!couponRates.empty(), "no coupon rates given");
+        QL_REQUIRE(!nominals.empty(), "no notional given");
+        QL_REQUIRE(!dayCounter.empty(), "no day counter given");
+
+        initializeDates(schedule, paymentAdjustment, paymentLag,
+                        paymentCalendar);
+
+        Size n = size();
+        nominals_.resize(n);
+        rates_.resize(n);
+        for (Size i=0; i<n; ++i) {
+            nominals_[i] = detail::get(nominals, i, 1.0);
+            rates_[i] = detail::get(couponRates, i, 0.0);
+        }
+    }
+
+    CompactLeg::CompactLeg(const Schedule& schedule,
+                           const ext::shared_ptr<IborIndex>& index,
+                           const std::vector<Real>& nominals,
+                           const std::vector<Real>& gearings,
+                           const std::vector<Spread>& spreads,
+                           const DayCounter& dayCounter,
+                           BusinessDayConvention paymentAdjustment,
+                           Natural fixingDays,
+                           Natural paymentLag,
+                           const Calendar& paymentCalendar)
+    : dayCounter_(dayCounter), compounding_(Simple), frequency_(Annual),
+      index_(index) {
+
+        QL_REQUIRE(index, "no index given");
+        QL_REQUIRE(!nominals.empty(), "no notional given");
+
+        if (dayCounter_.empty())
+            dayCounter_ = index->dayCounter();
+        fixingDays_ =
+            fixingDays == Null<Natural>() ? index->fixingDays() : fixingDays;
+
+        initializeDates(schedule, paymentAdjustment, paymentLag,
+                        paymentCalendar);
+
+        Size n = size();
+        QL_REQUIRE(gearings.size() <= n,
+                   "too many gearings (" << gearings.size() <<
+                   "), only " << n << " required");
+        QL_REQUIRE(spreads.size() <= n,
+                   "too many spreads (" << spreads.size() <<
+                   "), only " << n << " required");
+
+        const Calendar& fixingCalendar = index->fixingCalendar();
+        Natural indexFixingDays = index->fixingDays();
+
+        nominals_.resize(n);
+        gearings_.resize(n);
+        spreads_.resize(n);
+        fixingDates_.resize(n);
+        fixingValueDates_.resize(n);
+        fixingEndDates_.resize(n);
+        for (Size i=0; i<n; ++i) {
+            nominals_[i] = detail::get(nominals, i, 1.0);
+            gearings_[i] = detail::get(gearings, i, 1.0);
+            QL_REQUIRE(gearings_[i] != 0.0, "Null gearing not allowed");
+            spreads_[i] = detail::get(spreads, i, 0.0);
+
+            // same dates as IborCoupon
+            fixingDates_[i] = fixingCalendar.advance(
+                accrualStartDates_[i], -static_cast<Integer>(fixingDays_),
+                Days, Preceding);
+            fixingValueDates_[i] = fixingCalendar.advance(
+                fixingDates_[i], indexFixingDays, Days);
+            #ifdef QL_USE_INDEXED_COUPON
+            fixingEndDates_[i] = index->maturityDate(fixingValueDates_[i]);
+            #else
+            // par coupon approximation
+            Date nextFixingDate = fixingCalendar.advance(
+                accrualEndDates_[i], -static_cast<Integer>(fixingDays_),
+                Days);
+            fixingEndDates_[i] = fixingCalendar.advance(
+                nextFixingDate, indexFixingDays, Days);
+            #endif
+            QL_REQUIRE(fixingEndDates_[i] > fixingValueDates_[i],
+                       "cannot calculate forward rate between " <<
+                       fixingValueDates_[i] << " and " <<
+                       fixingEndDates_[i]);
+        }
+    }
+
+    void CompactLeg::initializeDates(const Schedule& schedule,
+                                     BusinessDayConvention paymentAdjustment,
+                                     Natural paymentLag,
+                                     Calendar paymentCalendar) {
+        QL_REQUIRE(schedule.size() > 1, "schedule with less than two dates");
+
+        Size n = schedule.size()-1;
+        const Calendar& calendar = schedule.calendar();
+        if (paymentCalendar.empty())
+            paymentCalendar = calendar;
+
+        paymentDates_.resize(n);
+        accrualStartDates_.resize(n);
+        accrualEndDates_.resize(n);
+        refPeriodStarts_.resize(n);
+        refPeriodEnds_.resize(n);
+
+        for (Size i=0; i<n; ++i) {
+            Date start = schedule.date(i), end = schedule.date(i+1);
+            accrualStartDates_[i] = refPeriodStarts_[i] = start;
+            accrualEndDates_[i] = refPeriodEnds_[i] = end;
+            paymentDates_[i] = paymentCalendar.advance(end, paymentLag, Days,
+                                                       paymentAdjustment);
+        }
+
+        // the first and last periods might be irregular; the
+        // reference periods are calculated as in FixedRateLeg and
+        // IborLeg, respectively.
+        if (!schedule.hasTenor())
+            return;
+        BusinessDayConvention bdc = schedule.businessDayConvention();
+        if (schedule.hasIsRegular() && !schedule.isRegular(1)) {
+            Date end = accrualEndDates_[0];
+            refPeriodStarts_[0] = index_ ?
+                calendar.adjust(end - schedule.tenor(), bdc) :
+                calendar.advance(end, -schedule.tenor(), bdc,
+                                 schedule.endOfMonth());
+        }
+        bool irregularLast = index_ ?
+            schedule.hasIsRegular() && !schedule.isRegular(n) :
+            n > 1 && !(schedule.hasIsRegular() && schedule.isRegular(n));
+        if (irregularLast) {
+            Date start = accrualStartDates_[n-1];
+            refPeriodEnds_[n-1] = index_ ?
+                calendar.adjust(start + schedule.tenor(), bdc) :
+                calendar.advance(start, schedule.tenor(), bdc,
+                                 schedule.endOfMonth());
+        }
+    }
+
+    Time CompactLeg::accrualPeriod(Size i) const {
+        QL_REQUIRE(i < size(), "coupon " << i << " out of range");
+        return dayCounter_.yearFraction(accrualStartDates_[i],
+                                        accrualEndDates_[i],
+                                        refPeriodStarts_[i],
+                                        refPeriodEnds_[i]);
+    }
+
+    Rate CompactLeg::indexFixing(Size i) const {
+        QL_REQUIRE(i < size(), "coupon " << i << " out of range");
+        if (!index_)
+            return rates_[i];
+
+        // same logic as IborCoupon::indexFixing
+        Date today = Settings::instance().evaluationDate();
+        const Date& fixingDate = fixingDates_[i];
+
+        if (fixingDate > today)
+            return forecastFixing(i);
+
+        if (fixingDate < today ||
+            Settings::instance().enforcesTodaysHistoricFixings()) {
+            // do not catch exceptions
+            Rate result = index_->pastFixing(fixingDate);
+            QL_REQUIRE(result != Null<Real>(),
+                       "Missing " << index_->name() << " fixing for "
+                       << fixingDate);
+            return result;
+        }
+
+        try {
+            Rate result = index_->pastFixing(fixingDate);
+            if (result != Null<Real>())
+                return result;
+        } catch (Error&) {
+            ;   // fall through and forecast
+        }
+        return forecastFixing(i);
+    }
+
+    Rate CompactLeg::forecastFixing(Size i) const {
+        Time t = index_->dayCounter().yearFraction(fixingValueDates_[i],
+                                                  fixingEndDates_[i]);
+        return index_->forecastFixing(fixingValueDates_[i],
+                                      fixingEndDates_[i], t);
+    }
+
+    Rate CompactLeg::rate(Size i) const {
+        if (!index_)
+            return indexFixing(i);
+        return gearings_[i] * indexFixing(i) + spreads_[i];
+    }
+
+    Real CompactLeg::amount(Size i) const {
+        QL_REQUIRE(i < size(), "coupon " << i << " out of range");
+        if (!index_) {
+            InterestRate r(rates_[i], dayCounter_, compounding_, frequency_);
+            return nominals_[i] * (r.compoundFactor(accrualStartDates_[i],
+                                                    accrualEndDates_[i],
+                                                    refPeriodStarts_[i],
+                                                    refPeriodEnds_[i]) - 1.0);
+        }
+        return nominals_[i] * rate(i) * accrualPeriod(i);
+    }
+
+    Real CompactLeg::accruedAmount(Size i, const Date& d) const {
+        QL_REQUIRE(i < size(), "coupon " << i << " out of range");
+        if (d <= accrualStartDates_[i] || d > paymentDates_[i])
+            return 0.0;
+
+        Date end = std::min(d, accrualEndDates_[i]);
+        if (!index_) {
+            InterestRate r(rates_[i], dayCounter_, compounding_, frequency_);
+            return nominals_[i] * (r.compoundFactor(accrualStartDates_[i],
+                                                    end,
+                                                    refPeriodStarts_[i],
+                                                    refPeriodEnds_[i]) - 1.0);
+        }
+        return nominals_[i] * rate(i) *
+            dayCounter_.yearFraction(accrualStartDates_[i], end,
+                                     refPeriodStarts_[i], refPeriodEnds_[i]);
+    }
+
+    bool CompactLeg::hasOccurred(Size i,
+                                 const Date& refDate,
+                                 boost::optional<bool> includeRefDate) const {
+        QL_REQUIRE(i < size(), "coupon " << i << " out of range");
+        // same logic as CashFlow::hasOccurred
+        const Date& paymentDate = paymentDates_[i];
+        if (refDate != Date()) {
+            if (refDate < paymentDate)
+                return false;
+            if (paymentDate < refDate)
+                return true;
+        }
+
+        Date today = Settings::instance().evaluationDate();
+        if (refDate == Date() || refDate == today) {
+            boost::optional<bool> includeToday =
+                Settings::instance().includeTodaysCashFlows();
+            if (includeToday)
+                includeRefDate = *includeToday;
+        }
+
+        Date d = refDate != Date() ? refDate : today;
+        bool includeRefDateEvent =
+            includeRefDate ? *includeRefDate :
+                           Settings::instance().includeReferenceDateEvents();
+        if (includeRefDateEvent)
+            return paymentDate < d;
+        else
+            return paymentDate <= d;
+    }
+
+    Leg CompactLeg::toLeg() const {
+        Size n = size();
+        Leg leg;
+        leg.reserve(n);
+        if (!index_) {
+            for (Size i=0; i<n; ++i) {
+                InterestRate r(rates_[i], dayCounter_,
+                               compounding_, frequency_);
+                leg.push_back(ext::shared_ptr<CashFlow>(new
+                    FixedRateCoupon(paymentDates_[i], nominals_[i], r,
+                                    accrualStartDates_[i],
+                                    accrualEndDates_[i],
+                                    refPeriodStarts_[i],
+                                    refPeriodEnds_[i])));
+            }
+        } else {
+            ext::shared_ptr<FloatingRateCouponPricer> pricer =
+                ext::make_shared<BlackIborCouponPricer>();
+            for (Size i=0; i<n; ++i) {
+                ext::shared_ptr<IborCoupon> coupon(
+                    new IborCoupon(paymentDates_[i], nominals_[i],
+                                   accrualStartDates_[i], accrualEndDates_[i],
+                                   fixingDays_, index_,
+                                   gearings_[i], spreads_[i],
+                                   refPeriodStarts_[i], refPeriodEnds_[i],
+                                   dayCounter_));
+                coupon->setPricer(pricer);
+                leg.push_back(coupon);
+            }
+        }
+        return leg;
+    }
+
+}
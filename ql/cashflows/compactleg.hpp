@@ -0,0 +1,179 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compactleg.hpp
+    \brief Leg of coupons stored by columns
+*/
+
+#ifndef quantlib_compact_leg_hpp
+#define quantlib_compact_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/compounding.hpp>
+#include <ql/time/schedule.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    class IborIndex;
+
+    //! leg of fixed-rate or Ibor coupons stored by columns
+    /*! The coupons are not stored as separate CashFlow instances;
+        instead, their dates, nominals and rates (or gearings and
+        spreads) are kept in one vector per field, while the day
+        counter, the compounding rule and the index are stored once
+        and shared by the whole leg.  No observer is registered at
+        construction.
+
+        Amounts are calculated on request.  Ibor coupons are priced
+        as by an IborCoupon with a BlackIborCouponPricer, i.e., as
+        par coupons without convexity adjustment; in-arrears fixing,
+        caps and floors are not supported.
+
+        The leg can be analyzed by means of the corresponding
+        CashFlows methods.  Instruments such as Bond or Swap still
+        need a Leg; one can be obtained by calling toLeg(), which
+        creates the coupons.
+
+        \warning since no observer is registered, instruments or
+                 calculations using the leg are not notified of
+                 changes in the index fixings or forecast curve.
+
+        \ingroup cashflows
+    */
+    class CompactLeg {
+      public:
+        //! \name Constructors
+        //@{
+        //! fixed-rate coupons
+        /*! As for FixedRateLeg, nominals and rates are given for
+            each coupon; if fewer values are passed, the last one is
+            used for the remaining coupons.
+        */
+        CompactLeg(const Schedule& schedule,
+                   const std::vector<Real>& nominals,
+                   const std::vector<Rate>& couponRates,
+                   const DayCounter& dayCounter,
+                   Compounding compounding = Simple,
+                   Frequency frequency = Annual,
+                   BusinessDayConvention paymentAdjustment = Following,
+                   Natural paymentLag = 0,
+                   const Calendar& paymentCalendar = Calendar());
+        //! Ibor coupons
+        /*! As for IborLeg, nominals, gearings and spreads are given
+            for each coupon; if fewer values are passed, the last one
+            is used for the remaining coupons.  Gearings default to
+            1 and spreads to 0; the day counter and fixing days
+            default to those of the index.
+        */
+        CompactLeg(const Schedule& schedule,
+                   const ext::shared_ptr<IborIndex>& index,
+                   const std::vector<Real>& nominals,
+                   const std::vector<Real>& gearings = std::vector<Real>(),
+                   const std::vector<Spread>& spreads = std::vector<Spread>(),
+                   const DayCounter& dayCounter = DayCounter(),
+                   BusinessDayConvention paymentAdjustment = Following,
+                   Natural fixingDays = Null<Natural>(),
+                   Natural paymentLag = 0,
+                   const Calendar& paymentCalendar = Calendar());
+        //@}
+        //! \name Inspectors
+        //@{
+        Size size() const { return paymentDates_.size(); }
+        bool empty() const { return paymentDates_.empty(); }
+        bool isFloating() const { return static_cast<bool>(index_); }
+        const DayCounter& dayCounter() const { return dayCounter_; }
+        Compounding compounding() const { return compounding_; }
+        Frequency frequency() const { return frequency_; }
+        const ext::shared_ptr<IborIndex>& index() const { return index_; }
+
+        const std::vector<Date>& paymentDates() const {
+            return paymentDates_;
+        }
+        const std::vector<Date>& accrualStartDates() const {
+            return accrualStartDates_;
+        }
+        const std::vector<Date>& accrualEndDates() const {
+            return accrualEndDates_;
+        }
+        const std::vector<Date>& referencePeriodStarts() const {
+            return refPeriodStarts_;
+        }
+        const std::vector<Date>& referencePeriodEnds() const {
+            return refPeriodEnds_;
+        }
+        const std::vector<Real>& nominals() const { return nominals_; }
+        //! fixed rates; empty for Ibor coupons
+        const std::vector<Rate>& couponRates() const { return rates_; }
+        //! empty for fixed-rate coupons
+        const std::vector<Real>& gearings() const { return gearings_; }
+        //! empty for fixed-rate coupons
+        const std::vector<Spread>& spreads() const { return spreads_; }
+        //! empty for fixed-rate coupons
+        const std::vector<Date>& fixingDates() const { return fixingDates_; }
+        //@}
+        //! \name Coupon calculations
+        //@{
+        //! accrual period of the i-th coupon as a fraction of year
+        Time accrualPeriod(Size i) const;
+        //! fixed rate or fixing of the i-th coupon
+        Rate indexFixing(Size i) const;
+        //! rate paid by the i-th coupon
+        Rate rate(Size i) const;
+        //! amount paid by the i-th coupon
+        Real amount(Size i) const;
+        //! amount accrued by the i-th coupon at the given date
+        Real accruedAmount(Size i, const Date& d) const;
+        //! whether the i-th coupon has been paid at the given date
+        /*! Same semantics as CashFlow::hasOccurred. */
+        bool hasOccurred(Size i,
+                         const Date& refDate = Date(),
+                         boost::optional<bool> includeRefDate =
+                                                    boost::none) const;
+        //@}
+        //! \name Conversion
+        //@{
+        //! creates the corresponding FixedRateCoupon or IborCoupon instances
+        Leg toLeg() const;
+        //@}
+      private:
+        void initializeDates(const Schedule& schedule,
+                             BusinessDayConvention paymentAdjustment,
+                             Natural paymentLag,
+                             Calendar paymentCalendar);
+        Rate forecastFixing(Size i) const;
+        // shared data
+        DayCounter dayCounter_;
+        Compounding compounding_;
+        Frequency frequency_;
+        ext::shared_ptr<IborIndex> index_;
+        Natural fixingDays_;
+        // coupon data
+        std::vector<Date> paymentDates_;
+        std::vector<Date> accrualStartDates_, accrualEndDates_;
+        std::vector<Date> refPeriodStarts_, refPeriodEnds_;
+        std::vector<Real> nominals_;
+        std::vector<Rate> rates_;
+        std::vector<Real> gearings_;
+        std::vector<Spread> spreads_;
+        std::vector<Date> fixingDates_, fixingValueDates_, fixingEndDates_;
+    };
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/vectors.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 
 using std::vector;
 
@@ -33,54 +34,41 @@ namespace QuantLib {
 
     namespace {
 
+        /* A pricer is created for each coupon, so that the cached
+           compounding of past fixings is not shared with other coupons;
+           as for other lazy calculations, a coupon shouldn't be priced
+           by several threads at the same time. */
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
+            OvernightIndexedCouponPricer()
+            : coupon_(0), fixedPeriods_(0),
+              pastFactor_(1.0), history_(0), revision_(0) {}
             void initialize(const FloatingRateCoupon& coupon) {
-                coupon_ = dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
-                QL_ENSURE(coupon_, "wrong coupon type");
+                const OvernightIndexedCoupon* c =
+                    dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
+                QL_ENSURE(c, "wrong coupon type");
+                if (c != coupon_) {
+                    coupon_ = c;
+                    history_ = 0;
+                }
             }
             Rate swapletRate() const {
 
                 ext::shared_ptr<OvernightIndex> index =
                     ext::dynamic_pointer_cast<OvernightIndex>(coupon_->index());
 
-                const vector<Date>& fixingDates = coupon_->fixingDates();
-                const vector<Time>& dt = coupon_->dt();
-
-                Size n = dt.size(),
-                     i = 0;
+                Size n = coupon_->dt().size();
 
-                Real compoundFactor = 1.0;
-
-                // already fixed part
+                // already fixed part; it only changes when the
+                // evaluation date moves or new fixings are stored
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[i]);
-                    compoundFactor *= (1.0 + pastFixing*dt[i]);
-                    ++i;
-                }
+                const FixingHistory& history = *index->fixingHistory();
+                if (today != today_ || &history != history_ ||
+                    history.revision() != revision_)
+                    compoundPastFixings(*index, history, today);
 
-                // today is a border case
-                if (i<n && fixingDates[i] == today) {
-                    // might have been fixed
-                    try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                        if (pastFixing != Null<Real>()) {
-                            compoundFactor *= (1.0 + pastFixing*dt[i]);
-                            ++i;
-                        } else {
-                            ;   // fall through and forecast
-                        }
-                    } catch (Error&) {
-                        ;       // fall through and forecast
-                    }
-                }
+                Size i = fixedPeriods_;
+                Real compoundFactor = pastFactor_;
 
                 // forward part using telescopic property in order
                 // to avoid the evaluation of multiple forward fixings
@@ -109,6 +97,51 @@ namespace QuantLib {
             Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
           protected:
             const OvernightIndexedCoupon* coupon_;
+          private:
+            void compoundPastFixings(const OvernightIndex& index,
+                                     const FixingHistory& history,
+                                     const Date& today) const {
+                const vector<Date>& fixingDates = coupon_->fixingDates();
+                const vector<Time>& dt = coupon_->dt();
+                Size n = dt.size();
+
+                Size i = std::lower_bound(fixingDates.begin(),
+                                          fixingDates.end(), today)
+                       - fixingDates.begin();
+
+                Real compoundFactor = 1.0;
+                for (Size j=0; j<i; ++j) {
+                    // rate must have been fixed
+                    Rate pastFixing = history[fixingDates[j]];
+                    QL_REQUIRE(pastFixing != Null<Real>(),
+                               "Missing " << index.name() <<
+                               " fixing for " << fixingDates[j]);
+                    compoundFactor *= (1.0 + pastFixing*dt[j]);
+                }
+
+                // today is a border case
+                if (i<n && fixingDates[i] == today) {
+                    // might have been fixed
+                    Rate pastFixing = history[fixingDates[i]];
+                    if (pastFixing != Null<Real>()) {
+                        compoundFactor *= (1.0 + pastFixing*dt[i]);
+                        ++i;
+                    } else {
+                        ;   // fall through and forecast
+                    }
+                }
+
+                fixedPeriods_ = i;
+                pastFactor_ = compoundFactor;
+                today_ = today;
+                history_ = &history;
+                revision_ = history.revision();
+            }
+            mutable Size fixedPeriods_;
+            mutable Real pastFactor_;
+            mutable Date today_;
+            mutable const FixingHistory* history_;
+            mutable unsigned long revision_;
         };
     }
 
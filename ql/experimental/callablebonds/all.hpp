@@ -7,4 +7,5 @@
 #include <ql/experimental/callablebonds/callablebondvolstructure.hpp>
 #include <ql/experimental/callablebonds/discretizedcallablefixedratebond.hpp>
 #include <ql/experimental/callablebonds/treecallablebondengine.hpp>
+#include <ql/experimental/callablebonds/treecallablebondportfoliopricer.hpp>
 
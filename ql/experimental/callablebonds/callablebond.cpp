@@ -142,6 +142,9 @@ namespace QuantLib {
         Real targetValue_;
     };
 
+    }
+
+    namespace detail {
 
     /* Convert a continuous spread to a conventional spread to a
        reference yield curve
@@ -261,7 +264,7 @@ namespace QuantLib {
         Real step = 0.001;
         Spread oas=solver.solve(obj, accuracy, guess, step);
 
-        return continuousToConv(oas,
+        return detail::continuousToConv(oas,
                                 *this,
                                 engineTS,
                                 dayCounter,
@@ -281,7 +284,7 @@ namespace QuantLib {
         if (settlement == Date())
             settlement = settlementDate();
 
-        oas=convToContinuous(oas,
+        oas=detail::convToContinuous(oas,
                              *this,
                              engineTS,
                              dayCounter,
@@ -202,6 +202,28 @@ namespace QuantLib {
                                CallableBond::results> {};
 
 
+    namespace detail {
+
+        /* Convert a continuous spread to a conventional spread to a
+           reference yield curve and vice versa.  Used by the OAS
+           calculations.
+        */
+        Real continuousToConv(Real oas,
+                              const Bond& b,
+                              const Handle<YieldTermStructure>& yts,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency);
+        Real convToContinuous(Real oas,
+                              const Bond& b,
+                              const Handle<YieldTermStructure>& yts,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency);
+
+    }
+
+
     //! callable/puttable fixed rate bond
     /*! Callable fixed rate bond class.
 
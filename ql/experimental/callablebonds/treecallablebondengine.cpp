@@ -47,6 +47,12 @@ namespace QuantLib {
         return calculateWithSpread(arguments_.spread);
     }
 
+    void TreeCallableFixedRateBondEngine::update() {
+        cachedLattice_.reset();
+        LatticeShortRateModelEngine<CallableBond::arguments,
+                                    CallableBond::results>::update();
+    }
+
     void TreeCallableFixedRateBondEngine::calculateWithSpread(Spread s) const {
         QL_REQUIRE(!model_.empty(), "no model specified");
 
@@ -72,16 +78,23 @@ namespace QuantLib {
             lattice = lattice_;
         } else {
             std::vector<Time> times = callableBond.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            if (!cachedLattice_ || times != cachedTimes_) {
+                TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+                cachedLattice_ = model_->tree(timeGrid);
+                cachedTimes_ = times;
+            }
+            lattice = cachedLattice_;
         }
 
-        if (s != 0.0) {
-            OneFactorModel::ShortRateTree *sr=
-                dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
-            QL_REQUIRE(sr,
-                       "Spread is not supported for trees other than OneFactorModel");
+        // the lattice might be reused, so the spread is always set
+        // (also when null) to override the one of previous calculations
+        OneFactorModel::ShortRateTree *sr=
+            dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
+        if (sr) {
             sr->setSpread(s);
+        } else {
+            QL_REQUIRE(s == 0.0,
+                       "Spread is not supported for trees other than OneFactorModel");
         }
 
         Time redemptionTime =
@@ -30,7 +30,14 @@
 namespace QuantLib {
 
     //! Numerical lattice engine for callable fixed rate bonds
-    /*! \ingroup callablebondengines */
+    /*! When built with a number of time steps, the engine keeps the
+        last lattice it built and reuses it for bonds with the same
+        mandatory times, until the model or the term structure
+        change.  This avoids rebuilding the lattice at each iteration
+        of the OAS calculation.
+
+        \ingroup callablebondengines
+    */
     class TreeCallableFixedRateBondEngine
         : public LatticeShortRateModelEngine<CallableBond::arguments,
                                              CallableBond::results> {
@@ -52,9 +59,14 @@ namespace QuantLib {
                                                  Handle<YieldTermStructure>()) ;
         //@}
         void calculate() const;
+        void update();
       private:
         void calculateWithSpread(Spread s) const;
         Handle<YieldTermStructure> termStructure_;
+        // lattice built for the last set of mandatory times, reused
+        // as long as they don't change (e.g., in OAS calculations)
+        mutable ext::shared_ptr<Lattice> cachedLattice_;
+        mutable std::vector<Time> cachedTimes_;
     };
 
     //! Numerical lattice engine for callable zero coupon bonds
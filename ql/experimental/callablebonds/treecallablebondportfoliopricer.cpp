@@ -0,0 +1,221 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/callablebonds/treecallablebondportfoliopricer.hpp>
+#include <ql/experimental/callablebonds/discretizedcallablefixedratebond.hpp>
+#include <ql/models/shortrate/onefactormodel.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        class LaterRedemption {
+          public:
+            explicit LaterRedemption(const std::vector<Time>& times)
+            : times_(times) {}
+            bool operator()(Size i, Size j) const {
+                return times_[i] > times_[j];
+            }
+          private:
+            const std::vector<Time>& times_;
+        };
+
+        class OASHelper {
+          public:
+            OASHelper(DiscretizedCallableFixedRateBond& bond,
+                      Time redemptionTime,
+                      const ext::shared_ptr<Lattice>& lattice,
+                      OneFactorModel::ShortRateTree& tree,
+                      Real targetValue)
+            : bond_(bond), redemptionTime_(redemptionTime),
+              lattice_(lattice), tree_(tree), targetValue_(targetValue) {}
+            Real operator()(Spread x) const {
+                tree_.setSpread(x);
+                bond_.initialize(lattice_, redemptionTime_);
+                bond_.rollback(0.0);
+                return targetValue_ - bond_.presentValue();
+            }
+          private:
+            DiscretizedCallableFixedRateBond& bond_;
+            Time redemptionTime_;
+            ext::shared_ptr<Lattice> lattice_;
+            OneFactorModel::ShortRateTree& tree_;
+            Real targetValue_;
+        };
+
+    }
+
+    TreeCallableBondPortfolioPricer::TreeCallableBondPortfolioPricer(
+                               const ext::shared_ptr<ShortRateModel>& model,
+                               Size timeSteps,
+                               const Handle<YieldTermStructure>& termStructure)
+    : model_(model), timeSteps_(timeSteps), termStructure_(termStructure) {
+        QL_REQUIRE(timeSteps>0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+    }
+
+    TreeCallableBondPortfolioPricer::TreeCallableBondPortfolioPricer(
+                               const ext::shared_ptr<ShortRateModel>& model,
+                               const TimeGrid& timeGrid,
+                               const Handle<YieldTermStructure>& termStructure)
+    : model_(model), timeSteps_(0), timeGrid_(timeGrid),
+      termStructure_(termStructure) {}
+
+    void TreeCallableBondPortfolioPricer::discretize(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    discretized_bonds& assets,
+                    std::vector<Time>& redemptionTimes) const {
+        QL_REQUIRE(model_, "no model specified");
+
+        Date referenceDate;
+        DayCounter dayCounter;
+
+        ext::shared_ptr<TermStructureConsistentModel> tsmodel =
+            ext::dynamic_pointer_cast<TermStructureConsistentModel>(model_);
+        if (tsmodel) {
+            referenceDate = tsmodel->termStructure()->referenceDate();
+            dayCounter = tsmodel->termStructure()->dayCounter();
+        } else {
+            referenceDate = termStructure_->referenceDate();
+            dayCounter = termStructure_->dayCounter();
+        }
+
+        assets.resize(bonds.size());
+        redemptionTimes.resize(bonds.size());
+        CallableBond::arguments arguments;
+        for (Size i=0; i<bonds.size(); ++i) {
+            bonds[i]->setupArguments(&arguments);
+            arguments.validate();
+            assets[i] = ext::make_shared<DiscretizedCallableFixedRateBond>(
+                                       arguments, referenceDate, dayCounter);
+            redemptionTimes[i] =
+                dayCounter.yearFraction(referenceDate,
+                                        arguments.redemptionDate);
+        }
+    }
+
+    ext::shared_ptr<Lattice> TreeCallableBondPortfolioPricer::lattice(
+                                      const discretized_bonds& assets) const {
+        if (!timeGrid_.empty())
+            return model_->tree(timeGrid_);
+
+        std::vector<Time> times;
+        for (Size i=0; i<assets.size(); ++i) {
+            std::vector<Time> t = assets[i]->mandatoryTimes();
+            times.insert(times.end(), t.begin(), t.end());
+        }
+        TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+        return model_->tree(timeGrid);
+    }
+
+    std::vector<Real> TreeCallableBondPortfolioPricer::values(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    Spread spread) const {
+        discretized_bonds assets;
+        std::vector<Time> redemptionTimes;
+        discretize(bonds, assets, redemptionTimes);
+        if (assets.empty())
+            return std::vector<Real>();
+
+        ext::shared_ptr<Lattice> lattice = this->lattice(assets);
+
+        OneFactorModel::ShortRateTree *tree =
+            dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
+        if (tree) {
+            tree->setSpread(spread);
+        } else {
+            QL_REQUIRE(spread == 0.0,
+                       "Spread is not supported for trees other than OneFactorModel");
+        }
+
+        // each bond is initialized at its redemption time and joins
+        // the ones already being rolled back; the latest are first.
+        std::vector<Size> order(assets.size());
+        for (Size i=0; i<order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         LaterRedemption(redemptionTimes));
+
+        std::vector<DiscretizedAsset*> active;
+        active.reserve(assets.size());
+        for (Size k=0; k<order.size(); ++k) {
+            Size i = order[k];
+            Time t = redemptionTimes[i];
+            if (!active.empty() && !close(active.front()->time(), t))
+                lattice->rollback(active, t);
+            assets[i]->initialize(lattice, t);
+            active.push_back(assets[i].get());
+        }
+        lattice->rollback(active, 0.0);
+
+        std::vector<Real> result(assets.size());
+        for (Size i=0; i<assets.size(); ++i)
+            result[i] = assets[i]->presentValue();
+        return result;
+    }
+
+    std::vector<Spread> TreeCallableBondPortfolioPricer::OAS(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    const std::vector<Real>& cleanPrices,
+                    const Handle<YieldTermStructure>& engineTS,
+                    const DayCounter& dayCounter,
+                    Compounding compounding,
+                    Frequency frequency,
+                    Real accuracy,
+                    Size maxIterations,
+                    Rate guess) const {
+        QL_REQUIRE(cleanPrices.size() == bonds.size(),
+                   "wrong number of clean prices (" << cleanPrices.size()
+                   << ") for " << bonds.size() << " bonds");
+
+        discretized_bonds assets;
+        std::vector<Time> redemptionTimes;
+        discretize(bonds, assets, redemptionTimes);
+        if (assets.empty())
+            return std::vector<Spread>();
+
+        ext::shared_ptr<Lattice> lattice = this->lattice(assets);
+
+        OneFactorModel::ShortRateTree *tree =
+            dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
+        QL_REQUIRE(tree,
+                   "Spread is not supported for trees other than OneFactorModel");
+
+        std::vector<Spread> result(assets.size());
+        for (Size i=0; i<assets.size(); ++i) {
+            Date settlement = bonds[i]->settlementDate();
+            Real dirtyPrice =
+                cleanPrices[i] + bonds[i]->accruedAmount(settlement);
+
+            OASHelper f(*assets[i], redemptionTimes[i],
+                        lattice, *tree, dirtyPrice);
+            Brent solver;
+            solver.setMaxEvaluations(maxIterations);
+            Real step = 0.001;
+            Spread oas = solver.solve(f, accuracy, guess, step);
+
+            result[i] = detail::continuousToConv(oas, *bonds[i], engineTS,
+                                                 dayCounter, compounding,
+                                                 frequency);
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file treecallablebondportfoliopricer.hpp
+    \brief Pricing of several callable bonds on a common lattice
+*/
+
+#ifndef quantlib_tree_callable_bond_portfolio_pricer_hpp
+#define quantlib_tree_callable_bond_portfolio_pricer_hpp
+
+#include <ql/experimental/callablebonds/callablebond.hpp>
+#include <ql/models/model.hpp>
+
+namespace QuantLib {
+
+    class DiscretizedCallableFixedRateBond;
+
+    //! Prices a set of callable fixed-rate bonds on a common lattice
+    /*! Instead of building a lattice for each bond, as
+        TreeCallableFixedRateBondEngine does, a single lattice is
+        built from the short-rate model on the union of the mandatory
+        times of the bonds; the bonds are then rolled back on it
+        together.  The results are the same returned by the engine
+        when given the same time grid.
+
+        The OAS calculation also builds a single lattice and reuses
+        it across the bonds and the iterations of the solver; only
+        the discount factors are recalculated when the spread
+        changes.
+
+        \ingroup callablebondengines
+    */
+    class TreeCallableBondPortfolioPricer {
+      public:
+        /*! \name Constructors
+            \note the term structure is only needed when the short-rate
+                  model cannot provide one itself.
+        */
+        //@{
+        TreeCallableBondPortfolioPricer(
+                           const ext::shared_ptr<ShortRateModel>& model,
+                           Size timeSteps,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
+        /*! \pre the time grid must contain the mandatory times of
+                 all the bonds.
+        */
+        TreeCallableBondPortfolioPricer(
+                           const ext::shared_ptr<ShortRateModel>& model,
+                           const TimeGrid& timeGrid,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
+        //@}
+        //! values of the bonds given a continuous spread over the model
+        std::vector<Real> values(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    Spread spread = 0.0) const;
+        //! option-adjusted spreads of the bonds
+        /*! The spreads are returned in the same convention as
+            CallableBond::OAS().
+        */
+        std::vector<Spread> OAS(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    const std::vector<Real>& cleanPrices,
+                    const Handle<YieldTermStructure>& engineTS,
+                    const DayCounter& dayCounter,
+                    Compounding compounding,
+                    Frequency frequency,
+                    Real accuracy = 1.0e-10,
+                    Size maxIterations = 100,
+                    Rate guess = 0.0) const;
+      private:
+        typedef std::vector<ext::shared_ptr<DiscretizedCallableFixedRateBond> >
+                                                             discretized_bonds;
+        void discretize(
+                    const std::vector<ext::shared_ptr<CallableBond> >& bonds,
+                    discretized_bonds& assets,
+                    std::vector<Time>& redemptionTimes) const;
+        ext::shared_ptr<Lattice> lattice(const discretized_bonds& assets) const;
+        ext::shared_ptr<ShortRateModel> model_;
+        Size timeSteps_;
+        TimeGrid timeGrid_;
+        Handle<YieldTermStructure> termStructure_;
+    };
+
+}
+
+#endif
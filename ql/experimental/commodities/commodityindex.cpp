@@ -40,7 +40,8 @@ namespace QuantLib {
         quotes_ = IndexManager::instance().getHistory(indexName);
         IndexManager::instance().setHistory(indexName, quotes_);
         registerWith(Settings::instance().evaluationDate());
-        registerWith(IndexManager::instance().notifier(name()));
+        fixingHistory_ = IndexManager::instance().registerHistory(name());
+        FixingHistory::registerObserver(fixingHistory_, this);
 
         if (forwardCurve_ != 0)
             // registerWith(forwardCurve_);
@@ -51,6 +52,11 @@ namespace QuantLib {
                                                 unitOfMeasure_);
     }
 
+    CommodityIndex::~CommodityIndex() {
+        // the history is shared with indexes in other threads
+        FixingHistory::unregisterObserver(fixingHistory_, this);
+    }
+
     std::ostream& operator<<(std::ostream& out, const CommodityIndex& index) {
         out << "[" << index.name_ << "] ("
             << index.currency_.code() << "/"
@@ -45,6 +45,7 @@ namespace QuantLib {
                 const ext::shared_ptr<CommodityCurve>& forwardCurve,
                 const ext::shared_ptr<ExchangeContracts>& exchangeContracts,
                 int nearbyOffset);
+        ~CommodityIndex();
         //! \name Index interface
         //@{
         std::string name() const;
@@ -98,6 +99,8 @@ namespace QuantLib {
         Real forwardCurveUomConversionFactor_;
         ext::shared_ptr<ExchangeContracts> exchangeContracts_;
         Integer nearbyOffset_;
+      private:
+        ext::shared_ptr<FixingHistory> fixingHistory_;
     };
 
 
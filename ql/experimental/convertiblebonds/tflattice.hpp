@@ -54,6 +54,14 @@ namespace QuantLib {
                       Array& newConversionProbability,
                       Array& newSpreadAdjustedRate) const;
         void rollback(DiscretizedAsset&, Time to) const;
+        /*! The assets are rolled back one at a time, so that each of
+            them goes through the rollback above; the faster version in
+            TreeLattice would skip the conversion logic.
+        */
+        void rollback(const std::vector<DiscretizedAsset*>& assets,
+                      Time to) const {
+            Lattice::rollback(assets, to);
+        }
         void partialRollback(DiscretizedAsset&, Time to) const;
 
       private:
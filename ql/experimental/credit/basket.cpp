@@ -334,6 +334,16 @@ namespace QuantLib {
         return cumulatedLoss() + lossModel_->expectedTrancheLoss(d);
     }
 
+    Disposable<std::vector<Real> > 
+        Basket::expectedTrancheLosses(const std::vector<Date>& dates) const {
+        calculate();
+        std::vector<Real> losses = lossModel_->expectedTrancheLosses(dates);
+        const Real realizedLoss = cumulatedLoss();
+        for (Size i = 0; i < losses.size(); i++)
+            losses[i] += realizedLoss;
+        return losses;
+    }
+
     Disposable<std::vector<Real> > 
         Basket::splitVaRLevel(const Date& date, Real loss) const {
         calculate();
@@ -377,6 +387,12 @@ namespace QuantLib {
 
     }
 
+    Disposable<std::vector<Probability> > Basket::probsAtLeastNEvents(Size n,
+        const std::vector<Date>& dates) const {
+        calculate();
+        return lossModel_->probsAtLeastNEvents(n, dates);
+    }
+
     Real Basket::recoveryRate(const Date& d, Size iName) const {
         calculate();
         return 
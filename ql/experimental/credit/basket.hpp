@@ -235,6 +235,12 @@ namespace QuantLib {
         */
         //@{
         Real expectedTrancheLoss(const Date& d) const;
+        /*! Expected tranche losses on a set of dates. Equivalent to calling
+            expectedTrancheLoss on each of them but lets the model share its
+            calculations among the dates.
+        */
+        Disposable<std::vector<Real> > expectedTrancheLosses(
+            const std::vector<Date>& dates) const;
         /*! The lossFraction is the fraction of losses expressed in 
             inception (no losses) tranche units (e.g. 'attach level'=0%, 
             'detach level'=100%)
@@ -271,6 +277,9 @@ namespace QuantLib {
         defaults in the basket portfolio at a given time.
         */
         Probability probAtLeastNEvents(Size n, const Date& d) const;
+        //! Same as above on a set of dates.
+        Disposable<std::vector<Probability> > probsAtLeastNEvents(Size n,
+            const std::vector<Date>& dates) const;
         /*! Expected recovery rate of the underlying position as a fraction of 
           its exposure value at date d _given_ it has defaulted _on_ that date.
           NOTICE THE ARG IS THE CTPTY....SHOULDNT IT BE THE POSITION/INSTRUMENT?????<<<<<<<<<<<<<<<<<<<<<<<
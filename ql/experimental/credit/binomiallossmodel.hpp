@@ -111,6 +111,9 @@ namespace QuantLib {
         Real percentile(const Date& d, Real percentile) const;
         Real expectedShortfall(const Date&d, Real percentile) const;
         Real expectedTrancheLoss(const Date& d) const;
+        //! Expected tranche losses on several dates in one integration.
+        Disposable<std::vector<Real> > expectedTrancheLosses(
+            const std::vector<Date>& dates) const;
     protected:
         // Model internal workings ----------------
         //! Average loss per credit.
@@ -120,6 +123,13 @@ namespace QuantLib {
             const std::vector<Real>& bsktNots,
             const std::vector<Probability>& uncondDefProbs, 
             const std::vector<Real>&) const;
+        //! Tranche losses on several dates for the same factor values.
+        Disposable<std::vector<Real> > condTrancheLosses(
+            const std::vector<Date>& dates, 
+            const std::vector<std::vector<Real> >& lossVals, 
+            const std::vector<std::vector<Real> >& bsktNots,
+            const std::vector<std::vector<Real> >& uncondDefProbsInv, 
+            const std::vector<Real>& mkf) const;
         // expected as in time-value, not average, see literature
         Disposable<std::vector<Real> >
             expConditionalLgd(const Date& d,
@@ -330,6 +340,21 @@ namespace QuantLib {
         return suma;
     }
 
+    template< class LLM>
+    Disposable<std::vector<Real> > BinomialLossModel<LLM>::condTrancheLosses(
+        const std::vector<Date>& dates, 
+        const std::vector<std::vector<Real> >& lossVals, 
+        const std::vector<std::vector<Real> >& bsktNots,
+        const std::vector<std::vector<Real> >& uncondDefProbsInv,
+        const std::vector<Real>& mkf) const {
+
+        std::vector<Real> losses(dates.size());
+        for(Size iDate=0; iDate<dates.size(); iDate++)
+            losses[iDate] = condTrancheLoss(dates[iDate], lossVals[iDate], 
+                bsktNots[iDate], uncondDefProbsInv[iDate], mkf);
+        return losses;
+    }
+
     template< class LLM>
     Real BinomialLossModel<LLM>::expectedTrancheLoss(const Date& d) const {
         using namespace ext::placeholders;
@@ -354,6 +379,34 @@ namespace QuantLib {
     }
 
 
+    template< class LLM>
+    Disposable<std::vector<Real> > 
+    BinomialLossModel<LLM>::expectedTrancheLosses(
+        const std::vector<Date>& dates) const {
+        using namespace ext::placeholders;
+        std::vector<std::vector<Real> > lossVals, notionals, invProbs;
+        for(Size iDate=0; iDate<dates.size(); iDate++) {
+            lossVals.push_back(lossPoints(dates[iDate]));
+            notionals.push_back(basket_->remainingNotionals(dates[iDate]));
+            invProbs.push_back(basket_->remainingProbabilities(dates[iDate]));
+            for(Size iName=0; iName<invProbs.back().size(); iName++)
+                invProbs.back()[iName] = copula_->inverseCumulativeY(
+                    invProbs.back()[iName], iName);
+        }
+
+        return copula_->integratedExpectedValue(
+            ext::function<Disposable<std::vector<Real> > (
+              const std::vector<Real>& v1)>(
+                ext::bind(&BinomialLossModel<LLM>::condTrancheLosses,
+                            this,
+                            ext::cref(dates), 
+                            ext::cref(lossVals), 
+                            ext::cref(notionals), 
+                            ext::cref(invProbs), 
+                            _1))
+            );
+    }
+
     template< class LLM>
     Disposable<std::map<Real, Probability> > 
         BinomialLossModel<LLM>::lossDistribution(const Date& d) const 
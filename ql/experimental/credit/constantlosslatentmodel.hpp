@@ -155,6 +155,11 @@ namespace QuantLib {
             return 
               ConstantLossLatentmodel<copulaPolicy>::probAtLeastNEvents(n, d);
         }
+        Disposable<std::vector<Probability> > probsAtLeastNEvents(Size n, 
+            const std::vector<Date>& dates) const {
+            return ConstantLossLatentmodel<copulaPolicy>::probsAtLeastNEvents(
+                n, dates);
+        }
         Real expectedRecovery(const Date& d, Size iName, 
             const DefaultProbKey& k) const {
                 return 
@@ -68,6 +68,19 @@ namespace QuantLib {
         virtual Real expectedTrancheLoss(const Date& d) const {
             QL_FAIL("expectedTrancheLoss Not implemented for this model.");
         }
+        /*! Expected tranche losses on a set of dates, e.g. the premium 
+            schedule of a tranche. The default implementation calls the
+            single date version for each date; models integrating on latent
+            factors should override it to share the integration among all 
+            the dates.
+        */
+        virtual Disposable<std::vector<Real> > expectedTrancheLosses(
+            const std::vector<Date>& dates) const {
+            std::vector<Real> losses(dates.size());
+            for(Size i=0; i<dates.size(); i++)
+                losses[i] = expectedTrancheLoss(dates[i]);
+            return losses;
+        }
         /*! Probability of the tranche losing the same or more than the 
             fractional amount given.
 
@@ -131,6 +144,17 @@ namespace QuantLib {
         virtual Probability probAtLeastNEvents(Size n, const Date& d) const {
             QL_FAIL("probAtLeastNEvents Not implemented for this model.");
         }
+        /*! Probabilities of having a given or larger number of defaults on
+            a set of dates. As above, the default implementation calls the 
+            single date version for each date.
+        */
+        virtual Disposable<std::vector<Probability> > probsAtLeastNEvents(
+            Size n, const std::vector<Date>& dates) const {
+            std::vector<Probability> probs(dates.size());
+            for(Size i=0; i<dates.size(); i++)
+                probs[i] = probAtLeastNEvents(n, dates[i]);
+            return probs;
+        }
         /*! Expected RR for name conditinal to default by that date.
         */
         virtual Real expectedRecovery(const Date&, Size iName, 
@@ -199,6 +199,14 @@ namespace QuantLib {
         // \todo: check the issuer has not defaulted.
         Real conditionalProbAtLeastNEvents(Size n, const Date& date,
             const std::vector<Real>& mktFactors) const;
+        /*! Conditional probabilities of n default events or more on several
+            dates, given the inverted unconditional probabilities of each name
+            on each date. The number of defaults is built recursively name by
+            name, the last bucket collecting n or more defaults.
+        */
+        Disposable<std::vector<Probability> > conditionalProbsAtLeastNEvents(
+            Size n, const std::vector<std::vector<Real> >& invUncondProbs,
+            const std::vector<Real>& mktFactors) const;
         //! access to integration:
         const ext::shared_ptr<LMIntegration>& 
             integration() const { return integration_; }
@@ -250,6 +258,34 @@ namespace QuantLib {
               _1)
              ));
         }
+        /*! Same as above on several dates. All the dates share the factor
+        integration.
+        */
+        Disposable<std::vector<Probability> > probsAtLeastNEvents(Size n, 
+            const std::vector<Date>& dates) const {
+            using namespace ext::placeholders;
+            QL_REQUIRE(basket_, "No portfolio basket set.");
+            const ext::shared_ptr<Pool>& pool = basket_->pool();
+            // avoid repeating the inversions in the integration:
+            std::vector<std::vector<Real> > invUncondProbs(dates.size(),
+                std::vector<Real>(basket_->size()));
+            for(Size iDate=0; iDate<dates.size(); iDate++)
+                for(Size i=0; i<basket_->size(); i++)
+                    invUncondProbs[iDate][i] = inverseCumulativeY(
+                        pool->get(pool->names()[i]).
+                        defaultProbability(basket_->defaultKeys()[i])->
+                        defaultProbability(dates[iDate]), i);
+            return integratedExpectedValue(
+             ext::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>& v1)>(
+              ext::bind(
+              &DefaultLatentModel<copulaPolicy>::conditionalProbsAtLeastNEvents,
+              this,
+              n,
+              ext::cref(invUncondProbs),
+              _1)
+             ));
+        }
     };
 
 
@@ -334,6 +370,34 @@ namespace QuantLib {
             return probNEventsOrMore;
         }
 
+    template<class CP>
+    Disposable<std::vector<Probability> > 
+        DefaultLatentModel<CP>::conditionalProbsAtLeastNEvents(Size n, 
+        const std::vector<std::vector<Real> >& invUncondProbs,
+        const std::vector<Real>& mktFactors) const {
+            std::vector<Probability> probs(invUncondProbs.size(), 1.);
+            if(n == 0) return probs;
+
+            // number of defaults distribution; the last bucket is n or more
+            std::vector<Probability> nDefaults(n+1);
+            for(Size iDate=0; iDate<invUncondProbs.size(); iDate++) {
+                const std::vector<Real>& invProbs = invUncondProbs[iDate];
+                std::fill(nDefaults.begin(), nDefaults.end(), 0.);
+                nDefaults[0] = 1.;
+                for(Size i=0; i<invProbs.size(); i++) {
+                    Probability pDef = conditionalDefaultProbabilityInvP(
+                        invProbs[i], i, mktFactors);
+                    nDefaults[n] += nDefaults[n-1] * pDef;
+                    for(Size k=n-1; k>0; k--)
+                        nDefaults[k] = nDefaults[k] * (1.-pDef) 
+                            + nDefaults[k-1] * pDef;
+                    nDefaults[0] *= 1.-pDef;
+                }
+                probs[iDate] = nDefaults[n];
+            }
+            return probs;
+        }
+
 
     // often used:
     typedef DefaultLatentModel<GaussianCopulaPolicy> GaussianDefProbLM;
@@ -42,14 +42,42 @@ namespace QuantLib {
         const Real inceptionTrancheNotional = 
             arguments_.basket->trancheNotional();
 
-        // compute expected loss at the beginning of first relevant period
-        Real e1 = 0;
+        /* Collect the integration dates first and request all the expected
+           losses at once, the model might share its calculations among
+           them. */
+        std::vector<Date> lossDates;
         // todo add includeSettlement date flows variable to engine.
         if (!arguments_.normalizedLeg[0]->hasOccurred(today)) 
              // cast to fixed rate coupon?
-            e1 = arguments_.basket->expectedTrancheLoss(
+            lossDates.push_back(
                 ext::dynamic_pointer_cast<Coupon>(
                     arguments_.normalizedLeg[0])->accrualStartDate()); 
+        for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
+            if(arguments_.normalizedLeg[i]->hasOccurred(today))
+                continue;
+            const ext::shared_ptr<Coupon> coupon =
+                ext::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[i]);
+            Date d, d0 = coupon->accrualStartDate();
+            const Date d2 = coupon->date();
+            do {
+                d = NullCalendar().advance(d0 > today ? d0 : today,
+                                           stepSize_);
+                if (d > d2) d = d2;
+                lossDates.push_back(d);
+                d0 = d;
+            }
+            while (d < d2);
+        }
+        const std::vector<Real> expectedLosses = 
+            arguments_.basket->expectedTrancheLosses(lossDates);
+        Size iLoss = 0;
+
+        // compute expected loss at the beginning of first relevant period
+        Real e1 = 0;
+        // todo add includeSettlement date flows variable to engine.
+        if (!arguments_.normalizedLeg[0]->hasOccurred(today)) 
+            e1 = expectedLosses[iLoss++]; 
         results_.expectedTrancheLoss.push_back(e1);// zero or realized losses?
 
         for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
@@ -69,11 +97,8 @@ namespace QuantLib {
             Date d, d0 = d1;
             Real e2;
             do {
-                d = NullCalendar().advance(d0 > today ? d0 : today,
-                                           stepSize_);
-                if (d > d2) d = d2;
-
-                e2 = arguments_.basket->expectedTrancheLoss(d);
+                d = lossDates[iLoss];
+                e2 = expectedLosses[iLoss++];
 
                 results_.premiumValue
                     // ..check for e2 including past/realized losses
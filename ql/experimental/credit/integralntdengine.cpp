@@ -45,6 +45,43 @@ namespace QuantLib {
         */
         bool basketIsHomogeneous = true;// hardcoded by now
 
+        /* Collect the dates at which the triggering probability is needed and
+        request them all at once, the model might share its calculations among
+        them. The loop below walks the same dates in the same order.
+        */
+        std::vector<Date> probDates;
+        for (Size i = 0; i < arguments_.premiumLeg.size(); i++) {
+            ext::shared_ptr<FixedRateCoupon> coupon =
+                ext::dynamic_pointer_cast<FixedRateCoupon>(
+                    arguments_.premiumLeg[i]);
+            Date d = arguments_.premiumLeg[i]->date();
+            if (d > discountCurve_->referenceDate()) {
+                probDates.push_back(d);
+                if (coupon->accrualStartDate() >= 
+                    discountCurve_->referenceDate())
+                    d = coupon->accrualStartDate();
+                else
+                    d = discountCurve_->referenceDate();
+                probDates.push_back(d);
+                Period stepSize = integrationStepSize_;
+                do {
+                    if(basketIsHomogeneous)
+                        probDates.push_back(d);
+                    d0 = d;
+                    d = d0 + stepSize;
+                    if (stepSize != 1*Days && d > coupon->accrualEndDate()) {
+                        stepSize = 1*Days;
+                        d = d0 + stepSize;
+                    }
+                }
+                while (d <= coupon->accrualEndDate());
+            }
+        }
+        const std::vector<Probability> probsAtLeastN = 
+            arguments_.basket->probsAtLeastNEvents(arguments_.ntdOrder, 
+                probDates);
+        Size iProb = 0;
+
         for (Size i = 0; i < arguments_.premiumLeg.size(); i++) {
             ext::shared_ptr<FixedRateCoupon> coupon =
                 ext::dynamic_pointer_cast<FixedRateCoupon>(
@@ -62,9 +99,7 @@ namespace QuantLib {
 
 */
                 // prob of contract not having been triggered by date of payment
-                Probability probNonTriggered = 
-                    1. - arguments_.basket->probAtLeastNEvents(
-                        arguments_.ntdOrder, d);
+                Probability probNonTriggered = 1. - probsAtLeastN[iProb++];
 
                 results_.premiumValue += arguments_.premiumLeg[i]->amount()
                     * discountCurve_->discount(d)
@@ -89,16 +124,14 @@ namespace QuantLib {
                 ///OVERKILL????
                     probsTriggering.end(), Real(0.));
 */
-                Probability defProb0 = arguments_.basket->probAtLeastNEvents(
-                        arguments_.ntdOrder, d0);
+                Probability defProb0 = probsAtLeastN[iProb++];
                 std::vector<Probability> probsTriggering, probsTriggering1;
                 do {
                     DiscountFactor disc = discountCurve_->discount(d);
 
                     Probability defProb1;
                     if(basketIsHomogeneous) {//take test out of the while loop
-                        defProb1 = arguments_.basket->probAtLeastNEvents(
-                            arguments_.ntdOrder, d);
+                        defProb1 = probsAtLeastN[iProb++];
                         claimValue -= (defProb1-defProb0)
                             * arguments_.basket->claim()->amount(d, 
                                 arguments_.notional, 
@@ -42,6 +42,21 @@ namespace QuantLib {
         const Real inceptionTrancheNotional = 
             arguments_.basket->trancheNotional();
 
+        // request all the expected losses at once, the model might share 
+        //   its calculations among the dates
+        std::vector<Date> lossDates;
+        if (!arguments_.normalizedLeg[0]->hasOccurred(today))
+            lossDates.push_back(
+                ext::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[0])->accrualStartDate());
+        for (Size i = 0; i < arguments_.normalizedLeg.size(); i++)
+            if(!arguments_.normalizedLeg[i]->hasOccurred(today))
+                lossDates.push_back(ext::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[i])->accrualEndDate());
+        const std::vector<Real> expectedLosses = 
+            arguments_.basket->expectedTrancheLosses(lossDates);
+        Size iLoss = 0;
+
         // compute expected loss at the beginning of first relevant period
         Real e1 = 0;
         // todo add includeSettlement date flows variable to engine.
@@ -50,9 +65,7 @@ namespace QuantLib {
             // acrrual and payment dates and today be in between
             // the tranche loss on that date might not be contingent but 
             // realized:
-            e1 = arguments_.basket->expectedTrancheLoss(
-                ext::dynamic_pointer_cast<Coupon>(
-                    arguments_.normalizedLeg[0])->accrualStartDate());
+            e1 = expectedLosses[iLoss++];
         results_.expectedTrancheLoss.push_back(e1);
         //'e1'  should contain the existing loses.....? use remaining amounts?
         for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
@@ -69,7 +82,7 @@ namespace QuantLib {
             // we assume the loss within the period took place on this date:
             Date defaultDate = startDate + (endDate-startDate)/2;
 
-            Real e2 = arguments_.basket->expectedTrancheLoss(endDate);
+            Real e2 = expectedLosses[iLoss++];
             results_.expectedTrancheLoss.push_back(e2);
             results_.premiumValue += 
                 ((inceptionTrancheNotional - e2) / inceptionTrancheNotional)
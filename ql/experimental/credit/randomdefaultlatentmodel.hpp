@@ -23,6 +23,7 @@
 
 #include <ql/math/beta.hpp>
 #include <ql/math/statistics/histogram.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
@@ -37,6 +38,8 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <algorithm>
+#include <map>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -69,6 +72,27 @@ namespace QuantLib {
     // replaces class Loss
     template <class simEventOwner> struct simEvent;
 
+    /*! Read only view on the events of a single simulation. The events of all
+    simulations are stored back to back in one buffer (with an offsets table
+    indexing the start of each simulation) instead of one vector per
+    simulation; this saves an allocation per scenario and keeps the statistics
+    scans on contiguous memory.
+    */
+    template <class simEventType>
+    class simEventRange {
+      public:
+        typedef const simEventType* const_iterator;
+        simEventRange(const_iterator begin, const_iterator end)
+        : begin_(begin), end_(end) {}
+        Size size() const { return static_cast<Size>(end_ - begin_); }
+        bool empty() const { return begin_ == end_; }
+        const simEventType& operator[](Size i) const { return begin_[i]; }
+        const_iterator begin() const { return begin_; }
+        const_iterator end() const { return end_; }
+      private:
+        const_iterator begin_, end_;
+    };
+
 
     /*! Base class for latent model monte carlo simulation. Independent of the
     copula type and the generator.
@@ -86,6 +110,12 @@ namespace QuantLib {
     positions that part of the problem will be starting to overtake the
     simulation costs.
 
+    Samples are drawn sequentially from the generator in blocks and the
+    events they determine are computed in parallel (when OpenMP is enabled);
+    the buffer contents do not depend on the number of threads. The tranched
+    losses per simulation are cached by date so that several statistics on
+    the same date take a single pass over the events.
+
     \todo: someone with sound experience on cache misses look into this, the
     statistics will be getting memory in and out of the cpu heavily and it
     might be possible to get performance out of that.
@@ -102,6 +132,42 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEventType;
+        // statistics accumulated in streaming mode, by date
+        struct streamedDateStatistics {
+            IncrementalStatistics trancheLoss;
+            // number of simulations with a given number of defaults
+            std::vector<Real> eventCounts;
+            // largest losses as a min-heap of (loss, slot in tailEvents)
+            Size tailSize;
+            std::vector<std::pair<Real, Size> > tail;
+            std::vector<std::vector<simEventType> > tailEvents;
+        };
+    public:
+        /*! Switches to streaming statistics: the simulated events are no
+        longer stored. Instead, for each of the given dates, the moments of
+        the tranche loss, the distribution of the number of defaults and the
+        largest tranche losses (a fraction tailProbability of the
+        simulations, together with their events) are accumulated as the
+        simulation runs. The memory used is then proportional to the tail
+        size rather than to the number of simulations.
+
+        In this mode percentiles and expected shortfalls are exact for
+        levels over 1-tailProbability, and VaR splits are available for
+        losses at or above the smallest loss kept in the tail. Statistics
+        needing the whole sample (loss distributions, default correlations,
+        n-th to default probabilities) or other dates are not available.
+
+        Passing no dates reverts to storing all the simulations.
+        */
+        void streamStatistics(const std::vector<Date>& dates,
+                              Probability tailProbability = 0.05) {
+            QL_REQUIRE(tailProbability > 0. && tailProbability <= 1.,
+                "tail probability must be in (0, 1]");
+            streamDates_ = dates;
+            tailProbability_ = tailProbability;
+            update();
+        }
     protected:
         RandomLM(Size numFactors,
             Size numLMVars,
@@ -109,10 +175,14 @@ namespace QuantLib {
             Size nSims,
             BigNatural seed)
         : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars),
-          nSims_(nSims), copula_(copula) {}
+          nSims_(nSims), tailProbability_(0.05), copula_(copula) {}
 
         void update() {
             simsBuffer_.clear();
+            simsOffsets_.clear();
+            tranchedLosses_.clear();
+            sortedTranchedLosses_.clear();
+            streamedStats_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -121,29 +191,122 @@ namespace QuantLib {
         void performCalculations() const {
             static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
                 this)->initDates();//in update?
+            initDefaultProbabilities();
             copulasRng_ = ext::make_shared<copulaRNG_type>(copula_, seed_);
             performSimulations();
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            simsBuffer_.clear();
+            simsOffsets_.assign(1, 0);
+            tranchedLosses_.clear();
+            sortedTranchedLosses_.clear();
+            streamedStats_.clear();
+            if(streaming())
+                initStreamedStatistics();
+            else
+                simsOffsets_.reserve(nSims_+1);
+
+            const Size blockSize =
+                std::min<Size>(nSims_, Size(simsBlockSize_));
+            std::vector<std::vector<Real> > samples(blockSize);
+            std::vector<std::vector<simEventType> > events(blockSize);
+            std::vector<std::string> errors(blockSize);
+            for(Size iSim=0; iSim < nSims_; iSim += blockSize) {
+                const Size n = std::min(blockSize, nSims_ - iSim);
+                /* The generator is sequential; drawing the block here keeps
+                the sequence (and the results) independent of the number of
+                threads used below. */
+                for(Size i=0; i<n; i++)
+                    samples[i] = copulasRng_->nextSequence().value;
+                /* Next sequence should determine the events in the sample.
+                Each thread works on its own copy of the copula; the default
+                probabilities were tabulated before, so that the term
+                structures are not accessed here. */
+                #pragma omp parallel
+                {
+                    const copulaPolicy copula(copula_);
+                    #pragma omp for schedule(dynamic, 64)
+                    for(long i=0; i<(long)n; i++) {
+                        events[i].clear();
+                        try {
+                            static_cast<const derivedRandomLM<copulaPolicy,
+                                USNG>* >(this)->nextSample(samples[i], copula,
+                                    events[i]);
+                        } catch (std::exception& e) {
+                            errors[i] = e.what();
+                        }
+                    }
+                }
+                for(Size i=0; i<n; i++) {
+                    QL_REQUIRE(errors[i].empty(),
+                        "simulation " << iSim + i << " failed: " << errors[i]);
+                    if(streaming()) {
+                        streamSample(events[i]);
+                    } else {
+                        simsBuffer_.insert(simsBuffer_.end(),
+                            events[i].begin(), events[i].end());
+                        simsOffsets_.push_back(simsBuffer_.size());
+                    }
+                }
             }
         }
 
+        /* Tabulates the default probability of each name for each day
+        from the reference date of its curve up to the maximum horizon.
+        The simulation reads these tables instead of the term structures,
+        which are lazily calculated and can't be used by several threads at
+        once. Names sharing a curve share its table. */
+        void initDefaultProbabilities() const;
+        /* Number of days from the curve reference date of the name to the
+        first day on which its default probability reaches the given value.
+        The value must not exceed the probability at the maximum horizon. */
+        Size defaultDay(Size iName, Probability p) const;
+        /* Tabulated default probability of the name at the given number of
+        days from the evaluation date. Days before the reference date of
+        the curve are moved to it. */
+        Probability tabulatedDefaultProbability(Size iName,
+                                                Integer days) const;
+
+        bool streaming() const { return !streamDates_.empty(); }
+        void initStreamedStatistics() const;
+        //! adds the events of one simulation to the streamed statistics
+        void streamSample(const std::vector<simEventType>& events) const;
+        const streamedDateStatistics& streamedStatistics(
+            const Date& d) const;
+
         /* Method to access simulation results and avoiding a copy of
         each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
+        Detaches the statistics access from the way the simulations are
         stored.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        simEventRange<simEvent<derivedRandomLM<copulaPolicy, USNG> > >
+            getSim(const Size iSim) const {
+            typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > eventType;
+            const eventType* events =
+                simsBuffer_.empty() ? 0 : &simsBuffer_[0];
+            return simEventRange<eventType>(events + simsOffsets_[iSim],
+                events + simsOffsets_[iSim+1]);
+        }
+
+        /* Tranched portfolio loss of each simulation at the given date, in
+        simulation order. Computed on first request and kept until the next
+        simulation. */
+        const std::vector<Real>& tranchedLosses(const Date& d) const;
+        /*! As above, sorted in increasing order (for rank statistics). In
+        streaming mode only the largest losses are returned; they rank last
+        in the whole sample. */
+        const std::vector<Real>& sortedTranchedLosses(const Date& d) const;
+        //! portfolio loss of a simulation at the given number of days
+        Real portfolioLoss(const simEventRange<simEventType>& events,
+                           Date::serial_type val) const;
+        /* Adds to the statistics the split of the tranche loss of a
+        simulation among the names defaulting in it. */
+        void addLossSplit(const simEventRange<simEventType>& events,
+                          Date::serial_type val,
+                          std::vector<simEventType>& eventsBuffer,
+                          std::vector<Real>& split,
+                          std::vector<GeneralStatistics>& splitStats) const;
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -217,14 +380,35 @@ namespace QuantLib {
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // events of all simulations; those of the i-th one lie in
+        //   [simsOffsets_[i], simsOffsets_[i+1])
+        mutable std::vector<simEvent<derivedRandomLM<copulaPolicy,
+            USNG > > > simsBuffer_;
+        mutable std::vector<Size> simsOffsets_;
+
+        mutable std::map<Date, std::vector<Real> > tranchedLosses_;
+        mutable std::map<Date, std::vector<Real> > sortedTranchedLosses_;
+
+        std::vector<Date> streamDates_;
+        Probability tailProbability_;
+        mutable std::map<Date, streamedDateStatistics> streamedStats_;
 
         mutable copulaPolicy copula_;
         mutable ext::shared_ptr<copulaRNG_type> copulasRng_;
 
+        // daily default probabilities, one table per curve
+        mutable std::vector<std::vector<Probability> > dailyDefaultPs_;
+        // days from the evaluation date to the reference date of each table
+        mutable std::vector<Integer> dailyDefaultPsOffsets_;
+        // table used by each name
+        mutable std::vector<Size> dailyDefaultPsIndex_;
+
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
+        // Number of samples drawn from the generator at a time
+        static const Size simsBlockSize_ = 4096;
+        // Number of dates kept in the tranched loss caches
+        static const Size maxCachedDates_ = 16;
         // Inversion probability limits are computed by children in initdates()
     };
 
@@ -245,10 +429,16 @@ namespace QuantLib {
         if(n==0) return 1.;
 
         Real counts = 0.;
+        if(streaming()) {
+            const std::vector<Real>& eventCounts =
+                streamedStatistics(d).eventCounts;
+            for(Size k=n; k<eventCounts.size(); k++)
+                counts += eventCounts[k];
+            return counts/nSims_;
+        }
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            const simEventRange<simEvent<D<C, URNG> > > events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -264,6 +454,8 @@ namespace QuantLib {
             const Date& d) const
     {
         calculate();
+        QL_REQUIRE(!streaming(),
+            "n-th to default probabilities not available in streaming mode");
         Size basketSize = basket_->size();
 
         QL_REQUIRE(n>0 && n<=basketSize, "Impossible number of defaults.");
@@ -275,7 +467,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange<simEvent<D<C, URNG> > > events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -308,6 +500,8 @@ namespace QuantLib {
     {
         // a control variate with the probabilities is possible
         calculate();
+        QL_REQUIRE(!streaming(),
+            "default correlation not available in streaming mode");
         Date today = Settings::instance().evaluationDate();
 
         QL_REQUIRE(d>today, "Date for statistic must be in the future.");
@@ -320,7 +514,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const simEventRange<simEvent<D<C, URNG> > > events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -344,48 +538,251 @@ namespace QuantLib {
 
 
     template<template <class, class> class D, class C, class URNG>
-    Real RandomLM<D, C, URNG>::expectedTrancheLoss(
-        const Date& d) const {
-            return expectedTrancheLossInterval(d, 0.95).first;
+    Real RandomLM<D, C, URNG>::portfolioLoss(
+        const simEventRange<simEventType>& events,
+        Date::serial_type val) const
+    {
+        Date today = Settings::instance().evaluationDate();
+        Real portfSimLoss=0.;
+        for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+            // if event is within time horizon...
+            if(val > static_cast<Date::serial_type>(
+                       events[iEvt].dayFromRef)) {
+                Size iName = events[iEvt].nameIdx;
+      // test needed (here and the others) to reuse simulations:
+      //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
+                    portfSimLoss +=
+                        basket_->exposure(basket_->names()[iName],
+                            Date(events[iEvt].dayFromRef +
+                                today.serialNumber())) *
+                                    (1.-getEventRecovery(events[iEvt]));
+            }
+        }
+        return portfSimLoss;
     }
 
 
     template<template <class, class> class D, class C, class URNG>
-    std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
-        const Date& d, Probability confidencePerc) const
+    const std::vector<Real>& RandomLM<D, C, URNG>::tranchedLosses(
+        const Date& d) const
     {
         calculate();
+        QL_REQUIRE(!streaming(),
+            "the full loss sample is not kept in streaming mode");
+        typename std::map<Date, std::vector<Real> >::const_iterator it =
+            tranchedLosses_.find(d);
+        if(it != tranchedLosses_.end()) return it->second;
+
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        // Real trancheLoss= 0.;
-        GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        // the entry is only added once complete
+        std::vector<Real> losses(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            losses[iSim] = std::min(std::max(
+                portfolioLoss(getSim(iSim), val) - attachAmount, 0.),
+                detachAmount - attachAmount);
+        if(tranchedLosses_.size() >= maxCachedDates_)
+            tranchedLosses_.clear();
+        std::vector<Real>& cached = tranchedLosses_[d];
+        cached.swap(losses);
+        return cached;
+    }
 
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
+
+    template<template <class, class> class D, class C, class URNG>
+    const std::vector<Real>& RandomLM<D, C, URNG>::sortedTranchedLosses(
+        const Date& d) const
+    {
+        calculate();
+        typename std::map<Date, std::vector<Real> >::const_iterator it =
+            sortedTranchedLosses_.find(d);
+        if(it != sortedTranchedLosses_.end()) return it->second;
+
+        // the entry is only added once complete
+        std::vector<Real> sorted;
+        if(streaming()) {
+            const std::vector<std::pair<Real, Size> >& tail =
+                streamedStatistics(d).tail;
+            sorted.reserve(tail.size());
+            for(Size i=0; i<tail.size(); i++)
+                sorted.push_back(tail[i].first);
+        } else {
+            sorted = tranchedLosses(d);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        if(sortedTranchedLosses_.size() >= maxCachedDates_)
+            sortedTranchedLosses_.clear();
+        std::vector<Real>& cached = sortedTranchedLosses_[d];
+        cached.swap(sorted);
+        return cached;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::initDefaultProbabilities() const {
+        Date today = Settings::instance().evaluationDate();
+        const ext::shared_ptr<Pool>& pool = basket_->pool();
+        const std::vector<DefaultProbKey> keys = basket_->defaultKeys();
+
+        std::vector<std::vector<Probability> > tables;
+        std::vector<Integer> offsets;
+        std::vector<Size> index(basket_->size());
+        std::map<const DefaultProbabilityTermStructure*, Size> curves;
+        for(Size iName=0; iName < basket_->size(); ++iName) {
+            const Handle<DefaultProbabilityTermStructure>& dfts =
+                pool->get(pool->names()[iName]).// use 'live' names
+                defaultProbability(keys[iName]);
+            std::pair<typename std::map<const DefaultProbabilityTermStructure*,
+                Size>::iterator, bool> inserted = curves.insert(
+                    std::make_pair(dfts.currentLink().get(), tables.size()));
+            if(inserted.second) {
+                Date ref = dfts->referenceDate();
+                tables.push_back(std::vector<Probability>(maxHorizon_+1));
+                for(Size iDay=0; iDay <= maxHorizon_; iDay++)
+                    tables.back()[iDay] = dfts->defaultProbability(
+                        ref + Period(static_cast<Integer>(iDay), Days), true);
+                offsets.push_back(ref - today);
+            }
+            index[iName] = inserted.first->second;
+        }
+        dailyDefaultPs_.swap(tables);
+        dailyDefaultPsOffsets_.swap(offsets);
+        dailyDefaultPsIndex_.swap(index);
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Size RandomLM<D, C, URNG>::defaultDay(Size iName, Probability p) const {
+        const std::vector<Probability>& ps =
+            dailyDefaultPs_[dailyDefaultPsIndex_[iName]];
+        /* Default times are whole days from the curve reference date, so
+        the first tabulated day reaching the probability inverts the curve
+        without a numerical solver. */
+        Size iDay = static_cast<Size>(
+            std::lower_bound(ps.begin(), ps.end(), p) - ps.begin());
+        return std::min(iDay, Size(maxHorizon_));
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Probability RandomLM<D, C, URNG>::tabulatedDefaultProbability(Size iName,
+        Integer days) const
+    {
+        Size iTable = dailyDefaultPsIndex_[iName];
+        Integer iDay = std::max(days - dailyDefaultPsOffsets_[iTable], 0);
+        QL_REQUIRE(iDay <= static_cast<Integer>(maxHorizon_),
+            "date beyond the simulation horizon");
+        return dailyDefaultPs_[iTable][iDay];
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::initStreamedStatistics() const {
+        // the largest tranche losses are kept, plus one to locate the
+        //   percentile at the tail boundary
+        const Size tailSize = std::min<Size>(nSims_,
+            static_cast<Size>(std::ceil(tailProbability_ * nSims_)) + 1);
+        for(Size iDate=0; iDate<streamDates_.size(); iDate++) {
+            streamedDateStatistics& stats = streamedStats_[streamDates_[iDate]];
+            stats.eventCounts.assign(basket_->size() + 1, 0.);
+            stats.tailSize = tailSize;
+            stats.tail.reserve(tailSize);
+            stats.tailEvents.reserve(tailSize);
+        }
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::streamSample(
+        const std::vector<simEventType>& events) const
+    {
+        Date today = Settings::instance().evaluationDate();
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+        const simEventType* begin = events.empty() ? 0 : &events[0];
+        const simEventRange<simEventType> simEvents(begin,
+                                                    begin + events.size());
+
+        typename std::map<Date, streamedDateStatistics>::iterator it;
+        for(it = streamedStats_.begin(); it != streamedStats_.end(); ++it) {
+            streamedDateStatistics& stats = it->second;
+            Date::serial_type val =
+                it->first.serialNumber() - today.serialNumber();
+
+            Size simCount = 0;
+            for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 if(val > static_cast<Date::serial_type>(
-					   events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
+                           events[iEvt].dayFromRef)) simCount++;
+            stats.eventCounts[simCount]++;
+
+            Real loss = std::min(std::max(
+                portfolioLoss(simEvents, val) - attachAmount, 0.),
+                detachAmount - attachAmount);
+            stats.trancheLoss.add(loss);
+
+            // keep the largest losses in a bounded min-heap
+            std::greater<std::pair<Real, Size> > heapOrder;
+            if(stats.tail.size() < stats.tailSize) {
+                stats.tail.push_back(
+                    std::make_pair(loss, stats.tailEvents.size()));
+                stats.tailEvents.push_back(events);
+                std::push_heap(stats.tail.begin(), stats.tail.end(),
+                               heapOrder);
+            } else if(!stats.tail.empty() && loss > stats.tail.front().first) {
+                std::pop_heap(stats.tail.begin(), stats.tail.end(),
+                              heapOrder);
+                Size slot = stats.tail.back().second;
+                stats.tail.back() = std::make_pair(loss, slot);
+                stats.tailEvents[slot] = events;
+                std::push_heap(stats.tail.begin(), stats.tail.end(),
+                               heapOrder);
             }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
         }
-        return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
-            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    const typename RandomLM<D, C, URNG>::streamedDateStatistics&
+        RandomLM<D, C, URNG>::streamedStatistics(const Date& d) const
+    {
+        calculate();
+        typename std::map<Date, streamedDateStatistics>::const_iterator it =
+            streamedStats_.find(d);
+        QL_REQUIRE(it != streamedStats_.end(),
+            "no statistics streamed for " << d);
+        return it->second;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Real RandomLM<D, C, URNG>::expectedTrancheLoss(
+        const Date& d) const {
+            return expectedTrancheLossInterval(d, 0.95).first;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
+        const Date& d, Probability confidencePerc) const
+    {
+        Real confidFactor =
+            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc));
+        if(streaming()) {
+            const IncrementalStatistics& lossStats =
+                streamedStatistics(d).trancheLoss;
+            return std::make_pair(lossStats.mean(),
+                lossStats.errorEstimate() * confidFactor);
+        }
+        const std::vector<Real>& losses = tranchedLosses(d);
+
+        GeneralStatistics lossStats;
+        lossStats.addSequence(losses.begin(), losses.end());
+        return std::make_pair(lossStats.mean(),
+            lossStats.errorEstimate() * confidFactor);
     }
 
 
@@ -409,40 +806,12 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
+        const std::vector<Real>& data = tranchedLosses(d);
 
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.push_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -456,50 +825,29 @@ namespace QuantLib {
         const Date today = Settings::instance().evaluationDate();
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
 
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					  events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
-        }
-
-        std::sort(losses.begin(), losses.end());
+        const std::vector<Real>& sortedLosses = sortedTranchedLosses(d);
         Real posit = std::ceil(percent * nSims_);
         posit = posit >= 0. ? posit : 0.;
         Size position = static_cast<Size>(posit);
-        Real perctlInf = losses[position];//q_{\alpha}
+        // in streaming mode only the upper ranks are available
+        Size firstRank = nSims_ - sortedLosses.size();
+        QL_REQUIRE(position >= firstRank,
+            "expected shortfall level outside the streamed tail");
+        std::vector<Real>::const_iterator itPerc =
+            sortedLosses.begin() + (position - firstRank);
+        Real perctlInf = *itPerc;//q_{\alpha}
 
         // the prob of values strictly larger than the quantile value.
         Probability probOverQ =
-            static_cast<Real>(std::distance(losses.begin() + position,
-                losses.end())) / static_cast<Real>(nSims_);
+            static_cast<Real>(std::distance(itPerc, sortedLosses.end()))
+                / static_cast<Real>(nSims_);
 
         return ( perctlInf * (1.-percent-probOverQ) +//<-correction term
-            std::accumulate(losses.begin() + position, losses.end(), 
+            std::accumulate(itPerc, sortedLosses.end(),
 			    Real(0.))/nSims_
                 )/(1.-percent);
 
@@ -533,8 +881,13 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Real RandomLM<D, C, URNG>::percentile(const Date& d, Real perc) const {
-        // need to specify return type in tuples' get is parametric
-        return percentileAndInterval(d, perc).template get<0>();
+        QL_REQUIRE(perc >= 0. && perc <= 1., "Incorrect percentile");
+        const std::vector<Real>& rankLosses = sortedTranchedLosses(d);
+        Size quantilePosition = static_cast<Size>(floor(nSims_*perc));
+        Size firstRank = nSims_ - rankLosses.size();
+        QL_REQUIRE(quantilePosition >= firstRank,
+            "percentile outside the streamed tail");
+        return rankLosses[quantilePosition - firstRank];
     }
 
 
@@ -551,38 +904,14 @@ namespace QuantLib {
 
         QL_REQUIRE(percentile >= 0. && percentile <= 1.,
             "Incorrect percentile");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        std::vector<Real> rankLosses;
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.push_back(portfSimLoss);
-        }
+        const std::vector<Real>& rankLosses = sortedTranchedLosses(d);
+        // in streaming mode only the upper ranks are available
+        Size firstRank = nSims_ - rankLosses.size();
 
-        std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
-        Real quantileValue = rankLosses[quantilePosition];
+        QL_REQUIRE(quantilePosition >= firstRank,
+            "percentile outside the streamed tail");
+        Real quantileValue = rankLosses[quantilePosition - firstRank];
 
         // compute confidence interval:
         const Probability confInterval = 0.95;// as an argument?
@@ -621,14 +950,73 @@ namespace QuantLib {
             s++;
             s = std::min(nSims_-1, s);
         }
-        lowerPercentile = rankLosses[r];
-        upperPercentile = rankLosses[s];
+        QL_REQUIRE(r >= firstRank,
+            "percentile interval outside the streamed tail");
+        lowerPercentile = rankLosses[r - firstRank];
+        upperPercentile = rankLosses[s - firstRank];
 
         return boost::tuples::tuple<Real, Real, Real>(quantileValue,
             lowerPercentile, upperPercentile);
     }
 
 
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::addLossSplit(
+        const simEventRange<simEventType>& events,
+        Date::serial_type val,
+        std::vector<simEventType>& splitEventsBuffer,
+        std::vector<Real>& split,
+        std::vector<GeneralStatistics>& splitStats) const
+    {
+        Date today = Settings::instance().evaluationDate();
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+
+        splitEventsBuffer.clear();
+        for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+            if(val > static_cast<Date::serial_type>(
+                     events[iEvt].dayFromRef))
+                //and will sort later if buffer applies:
+                splitEventsBuffer.push_back(events[iEvt]);
+        }
+
+        /* second pass; split is conditional to total losses within target
+        losses/percentile:  */
+        Real ptflCumulLoss = 0.;
+        std::sort(splitEventsBuffer.begin(), splitEventsBuffer.end());
+        //NOW THIS:
+        split.assign(split.size(), 0.);
+        /*  if the name triggered a loss in the portf limits assign
+        this loss to that name..  */
+        for(Size i=0; i<splitEventsBuffer.size(); i++) {
+            Size iName = splitEventsBuffer[i].nameIdx;
+            Real lossName =
+        // allows amortizing (others should be like this)
+        // basket_->remainingNotionals(Date(simsBuffer_[i].dayFromRef +
+        //      today.serialNumber()))[iName] *
+                basket_->exposure(basket_->names()[iName],
+                    Date(splitEventsBuffer[i].dayFromRef +
+                        today.serialNumber())) *
+                        (1.-getEventRecovery(splitEventsBuffer[i]));
+
+            Real tranchedLossBefore =
+                std::min(std::max(ptflCumulLoss - attachAmount, 0.),
+                detachAmount - attachAmount);
+            ptflCumulLoss += lossName;
+            Real tranchedLossAfter =
+                std::min(std::max(ptflCumulLoss - attachAmount, 0.),
+                detachAmount - attachAmount);
+            // assign new losses:
+            split[iName] += tranchedLossAfter - tranchedLossBefore;
+        }
+        for(Size iName=0; iName<split.size(); iName++) {
+            splitStats[iName].add(split[iName] /
+                std::min(std::max(ptflCumulLoss - attachAmount, 0.),
+                    detachAmount - attachAmount) );
+        }
+    }
+
+
     template<template <class, class> class D, class C, class URNG>
     Disposable<std::vector<Real> > RandomLM<D, C, URNG>::splitVaRLevel(
         const Date& date, Real loss) const
@@ -652,9 +1040,6 @@ namespace QuantLib {
         /* Check 'loss' value integrity: i.e. is within tranche limits? (should
             have been done basket...)*/
         calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
         Size numLiveNames = basket_->remainingSize();
 
         std::vector<Real> split(numLiveNames, 0.);
@@ -663,64 +1048,30 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            //std::vector<Real> splitBuffer(numLiveNames_, 0.);
-            std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
-
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                // if(basket_->pool()->has(copula_->pool()->names()[iName])) {
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                        //and will sort later if buffer applies:
-                        splitEventsBuffer.push_back(events[iEvt]);
-                }
+        std::vector<simEventType> splitEventsBuffer;
+        if(streaming()) {
+            const streamedDateStatistics& stats = streamedStatistics(date);
+            /* the simulations with losses over the level must all be in the
+            tail; they are unless it was filled with larger losses */
+            QL_REQUIRE(stats.tail.size() < stats.tailSize ||
+                       loss >= stats.tail.front().first,
+                "VaR level outside the streamed tail");
+            for(Size i=0; i<stats.tail.size(); i++) {
+                if(stats.tail[i].first <= loss) continue;
+                const std::vector<simEventType>& events =
+                    stats.tailEvents[stats.tail[i].second];
+                const simEventType* begin = events.empty() ? 0 : &events[0];
+                addLossSplit(simEventRange<simEventType>(begin,
+                    begin + events.size()), val, splitEventsBuffer, split,
+                    splitStats);
             }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-
-            /* second pass; split is conditional to total losses within target
-            losses/percentile:  */
-            Real ptflCumulLoss = 0.;
-            if(portfSimLoss > loss) {
-                std::sort(splitEventsBuffer.begin(), splitEventsBuffer.end());
-                //NOW THIS:
-                split.assign(numLiveNames, 0.);
-                /*  if the name triggered a loss in the portf limits assign
-                this loss to that name..  */
-                for(Size i=0; i<splitEventsBuffer.size(); i++) {
-                    Size iName = splitEventsBuffer[i].nameIdx;
-                    Real lossName =
-            // allows amortizing (others should be like this)
-            // basket_->remainingNotionals(Date(simsBuffer_[i].dayFromRef +
-            //      today.serialNumber()))[iName] *
-                        basket_->exposure(basket_->names()[iName],
-                            Date(splitEventsBuffer[i].dayFromRef +
-                                today.serialNumber())) *
-                                (1.-getEventRecovery(splitEventsBuffer[i]));
-
-                    Real tranchedLossBefore =
-                        std::min(std::max(ptflCumulLoss - attachAmount, 0.),
-                        detachAmount - attachAmount);
-                    ptflCumulLoss += lossName;
-                    Real tranchedLossAfter =
-                        std::min(std::max(ptflCumulLoss - attachAmount, 0.),
-                        detachAmount - attachAmount);
-                    // assign new losses:
-                    split[iName] += tranchedLossAfter - tranchedLossBefore;
-                }
-                for(Size iName=0; iName<numLiveNames; iName++) {
-                    splitStats[iName].add(split[iName] /
-                        std::min(std::max(ptflCumulLoss - attachAmount, 0.),
-                            detachAmount - attachAmount) );
-                }
+        } else {
+            const std::vector<Real>& losses = tranchedLosses(date);
+            for(Size iSim=0; iSim < nSims_; iSim++) {
+                // the tranched loss is known, only the tail sims are scanned
+                if(losses[iSim] <= loss) continue;
+                addLossSplit(getSim(iSim), val, splitEventsBuffer, split,
+                    splitStats);
             }
         }
 
@@ -824,7 +1175,8 @@ namespace QuantLib {
         // \todo Consider this to be only a ConstantLossLM instead
         const ext::shared_ptr<DefaultLatentModel<copulaPolicy> > model_;
         const std::vector<Real> recoveries_;
-        // for time inversion:
+        /* Accuracy of the former numerical time inversion; default times
+        are now read off the daily default probability tables. */
         Real accuracy_;
     public:
         // \todo: Allow a constructor building its own default latent model.
@@ -877,7 +1229,11 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        /* Appends the events determined by the sample to the passed
+        buffer. It is called concurrently on different samples. */
+        void nextSample(const std::vector<Real>& values,
+                        const copulaPolicy& copula,
+                        std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -887,6 +1243,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -936,28 +1293,20 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        const C& copula,
+        std::vector<defaultSimEvent>& events) const
     {
-        const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
-
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
                 model_->latentVarValue(values, iName);
             Probability simDefaultProb =
-               model_->cumulativeY(latentVarSample, iName);
+               copula.cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
-                const Handle<DefaultProbabilityTermStructure>& dfts =
-                    pool->get(pool->names()[iName]).// use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
                 // compute and store default time with respect to the
                 //  curve ref date:
-                Size dateSTride =
-                    static_cast<Size>(Brent().solve(// casted from Real:
-                        detail::Root(dfts, simDefaultProb),
-                            accuracy_,0.,1.));
+                Size dateSTride = this->defaultDay(iName, simDefaultProb);
                    /*
                    // value if one approximates to a flat HR;
                    //   faster (>x2) but it introduces an error:..
@@ -968,7 +1317,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
+                events.push_back(defaultSimEvent(iName,
                     dateSTride));
                //emplace_back
             }
@@ -75,7 +75,8 @@ namespace QuantLib {
         typedef simEvent<RandomLossLM> defaultSimEvent;
 
         const ext::shared_ptr<SpotRecoveryLatentModel<copulaPolicy> > copula_;
-        // for time inversion:
+        /* Accuracy of the former numerical time inversion; default times
+        are now read off the daily default probability tables. */
         Real accuracy_;
     public:
         RandomLossLM(
@@ -102,7 +103,11 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        /* Appends the events determined by the sample to the passed
+        buffer. It is called concurrently on different samples. */
+        void nextSample(const std::vector<Real>& values,
+                        const copulaPolicy& copula,
+                        std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -114,6 +119,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -155,11 +161,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        const C& copula,
+        std::vector<defaultSimEvent>& events) const
     {
-        const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
-
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
             // ...but samples must be full
@@ -173,17 +178,12 @@ namespace QuantLib {
             Real latentVarSample = 
                 copula_->latentVarValue(values, iName);
             Probability simDefaultProb = 
-                copula_->cumulativeY(latentVarSample, iName);
+                copula.cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
-                const Handle<DefaultProbabilityTermStructure>& dfts = 
-                    pool->get(pool->names()[iName]).  // use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
                 // compute and store default time with respect to the 
                 //  curve ref date:
-                Size dateSTride =
-                    static_cast<Size>(Brent().solve(// casted from Real:
-                    detail::Root(dfts, simDefaultProb), accuracy_, 0., 1.));
+                Size dateSTride = this->defaultDay(iName, simDefaultProb);
                 /*
                 // value if one approximates to a flat HR; 
                 //   faster (>x2) but it introduces an error:..
@@ -202,17 +202,15 @@ namespace QuantLib {
                 probability the date is moved to the TS date 
                 Unless the gap is ridiculous this has no practical effect for 
                 the RR value*/
-                Date today = Settings::instance().evaluationDate();
-                Date eventDate = today+Period(static_cast<Integer>(dateSTride), 
-                    Days);
-                if(eventDate<dfts->referenceDate()) 
-                    eventDate = dfts->referenceDate();
+                Probability eventDefaultProb =
+                    this->tabulatedDefaultProbability(iName,
+                        static_cast<Integer>(dateSTride));
                 Real latentRRVarSample = 
                     copula_->latentRRVarValue(values, iName);
                 Real recovery = 
-                    copula_->conditionalRecovery(latentRRVarSample,
-                        iName, eventDate);
-                this->simsBuffer_.back().push_back(
+                    copula_->conditionalRecoveryP(eventDefaultProb,
+                        latentRRVarSample, iName, copula);
+                events.push_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
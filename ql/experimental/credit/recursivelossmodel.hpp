@@ -24,6 +24,7 @@
 #include <ql/experimental/credit/defaultlossmodel.hpp>
 #include <ql/functional.hpp>
 #include <map>
+#include <numeric>
 #include <algorithm>
 
 namespace QuantLib {
@@ -37,64 +38,90 @@ namespace QuantLib {
         Notice that using copulas other than Gaussian it is only an
         approximation (see remark on p.68).
 
+        The inverted unconditional probabilities and the integrated loss 
+        distribution are cached by date. Since they do not depend on the 
+        tranche limits they are reused when the model is reassigned to other 
+        baskets with the same loss weights (e.g. pricing a tranche ladder) as 
+        long as the unconditional probabilities have not changed.
+
         \todo Make the loss unit equal to some small fraction depending on the
         portfolio loss weights (notionals and recoveries). As it is now this
         is ok for pricing but not for risk metrics. See the discussion in O'Kane
         18.3.2
-        \todo Intengrands should all use the inverted probabilities for 
-        performance instead of calling the copula inversion with the same vals.
     */
     template<class copulaPolicy> 
-    class RecursiveLossModel : public DefaultLossModel {
+    class RecursiveLossModel : public DefaultLossModel, 
+        public virtual Observer {
     public:
         RecursiveLossModel(
             const ext::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& m,
 // nope! use max common divisor. See O'Kane. Or give both options at least.
             Size nbuckets  = 1)
-        : copula_(m), nBuckets_(nbuckets), wk_() { }
+        : copula_(m), nBuckets_(nbuckets), wk_() {
+            registerWith(copula_);
+        }
+        // react to changes in the latent model factors
+        void update() {
+            distributions_.clear();
+            // tell basket to notify instruments, etc, we are invalid
+            if(!basket_.empty()) basket_->notifyObservers();
+        }
       private:
-          /*!
-          @param pDefDate Vector of unconditional default probabilities for each
-          live name (at the current evaluation date). This is passed instead of 
-          the date for performance reasons (if in the future other magnitudes 
-          -e.g. lgd- are contingent on the date they shouldd be passed too).
-          */
-        Disposable<std::map<Real, Probability> > conditionalLossDistrib(
-            const std::vector<Probability>& pDefDate, 
-            const std::vector<Real>& mktFactor) const;
-        Real expectedConditionalLoss(const std::vector<Probability>& pDefDate, //<< never used!!
-            const std::vector<Real>& mktFactor) const;
-        Disposable<std::vector<Real> > conditionalLossProb(
-            const std::vector<Probability>& pDefDate, 
-            //const Date& date,
-            const std::vector<Real>& mktFactor) const;
-        //versions using the P-inverse, deprecate the former
-        Disposable<std::map<Real, Probability> > conditionalLossDistribInvP(
-            const std::vector<Real>& pDefDate, 
-            //const Date& date,
+        //! Unconditional magnitudes of the live pool at a given date.
+        struct dateDistribution {
+            //! unconditional default probabilities of each live name
+            std::vector<Probability> uncDefProb;
+            //! their copula inversions
+            std::vector<Real> invUncDefProb;
+            //! probabilities of each attainable loss
+            std::vector<Probability> lossProb;
+        };
+        /*! Brings the cached distributions at the dates up to date. Those 
+            not there or whose default probabilities have moved are computed
+            in a single integration over the latent factors.
+        */
+        void updateDistributions(const std::vector<Date>& dates) const;
+        //! Returns the cached distribution at the date, updating it first.
+        const dateDistribution& distribution(const Date& date) const;
+        //! Expected tranche loss of an unconditional loss distribution.
+        Real expectedTrancheLossImpl(
+            const std::vector<Probability>& lossProb) const;
+        /*! Conditional probabilities of losing each number of loss units, 
+            attainable or not.
+
+          @param invpDefDate Vector of inverted unconditional default 
+          probabilities for each live name (at the current evaluation date). 
+          This is passed instead of the date for performance reasons (if in 
+          the future other magnitudes -e.g. lgd- are contingent on the date 
+          they shouldd be passed too).
+        */
+        Disposable<std::vector<Probability> > conditionalLossDistribInvP(
+            const std::vector<Real>& invpDefDate, 
             const std::vector<Real>& mktFactor) const;
-        Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate, 
-            //const Date& date,
+        /*! Conditional probabilities of the attainable losses only, on 
+            several dates one after the other.
+        */
+        Disposable<std::vector<Real> > conditionalLossProbsInvP(
+            const std::vector<std::vector<Real> >& invpDefDates, 
             const std::vector<Real>& mktFactor) const;
     protected:
         void resetModel();
     public:
         /*  Expected tranche Loss calculation.
             This is computed from the first equation on page 70 (not numbered)
-            Notice that while we want to compute:
             \f[
             EL(t) = \sum_{l_k}l_k P(l;t) =
               \sum_{l_k}l_k \int P(l_k;t|\omega) d\omega q(\omega)
             \f]
-            One can invert the sumation and the integral order to:
-            \f[
-            EL(t) = \int\,q(\omega)\,d\omega\,\sum_{l_k}\,l_k\,P(l_k;t|\omega) =
-              \int\,q(\omega)\,d\omega\,EL(t|\omega)
-            \f]
-            and this is the way it is integrated here. The recursion formula 
-            makes it easier this way.
+            The sumation and the integral order could be inverted so that only
+            the conditional expected loss is integrated, but then the 
+            integration would be tied to the tranche limits. Integrating the 
+            distribution first allows sharing it between all the tranches and
+            statistics requested on the pool at the same date.
         */
        Real expectedTrancheLoss(const Date& date) const;
+       Disposable<std::vector<Real> > expectedTrancheLosses(
+           const std::vector<Date>& dates) const;
        Disposable<std::vector<Real> > lossProbability(const Date& date) const;
        // REMEBER THIS HAS TO BE MOVED TO A DISTRIBUTION OBJECT.............
        Disposable<std::map<Real, Probability> > lossDistribution(
@@ -109,7 +136,10 @@ namespace QuantLib {
     private:
         // loss model descriptor members
         const Size nBuckets_;
-        mutable std::vector<Real> wk_;
+        //! loss of each live name in loss units
+        mutable std::vector<Size> wk_;
+        //! attainable portfolio losses in loss units, ascending
+        mutable std::vector<Size> attainableLosses_;
         mutable Real lossUnit_;
         //! name to name factor. In the single factor copula:
         //    correl = beta * beta
@@ -122,6 +152,7 @@ namespace QuantLib {
             notional_;
         mutable Size remainingBsktSize_;
         mutable std::vector<Real> notionals_;
+        mutable std::map<Date, dateDistribution> distributions_;
     };
 
 
@@ -130,82 +161,103 @@ namespace QuantLib {
     // Inlines ------------------------------------------------
 
     template<class CP>
-    inline Real RecursiveLossModel<CP>::expectedTrancheLoss(
-        const Date& date) const 
-    {
-/*
-        std::map<Real, Probability> dist = lossDistribution(date);
-
-        Real expLoss = 0.;
-        std::map<Real, Probability>::iterator distIt = dist.begin();
-
-        while(distIt != dist.end()) {
-            Real loss = distIt->first * lossUnit_;
-            loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            // MIN MAX BUGS ....??
-            expLoss += loss * distIt->second;
-            distIt++;
-        }
-        return expLoss ;
-
+    void RecursiveLossModel<CP>::updateDistributions(
+        const std::vector<Date>& dates) const {
 
+        using namespace ext::placeholders;
 
+        std::vector<dateDistribution*> outdated;
+        std::vector<std::vector<Real> > invProbs;
+        for(Size iDate=0; iDate<dates.size(); ++iDate) {
+            std::vector<Probability> uncDefProb = 
+                basket_->remainingProbabilities(dates[iDate]);
+            typename std::map<Date, dateDistribution>::iterator cached = 
+                distributions_.find(dates[iDate]);
+            if(cached != distributions_.end() 
+                && cached->second.uncDefProb == uncDefProb
+                && !cached->second.lossProb.empty())
+                continue;
+
+            dateDistribution& dist = distributions_[dates[iDate]];
+            // repeated date
+            if(std::find(outdated.begin(), outdated.end(), &dist) 
+                != outdated.end())
+                continue;
+            dist.uncDefProb.swap(uncDefProb);
+            // invert the unconditional Ps once; the integrand is called at
+            //   every factor node
+            dist.invUncDefProb.resize(remainingBsktSize_);
+            for(Size i=0; i<remainingBsktSize_; ++i)
+                dist.invUncDefProb[i] = 
+                    copula_->inverseCumulativeY(dist.uncDefProb[i], i);
+            dist.lossProb.clear();
+            outdated.push_back(&dist);
+            invProbs.push_back(dist.invUncDefProb);
+        }
+        if(outdated.empty()) return;
 
-    ///////////////////////////////////////////////////////////////////////
-
-        // calculate inverted unconditional Ps first so we save the inversion:
-        // TO DO : turn to STL algorithm code
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-
-        return copula_->integratedExpectedValue(
-            ext::function<Real (const std::vector<Real>& v1)>(
+        std::vector<Real> lossProbs = copula_->integratedExpectedValue(
+            ext::function<Disposable<std::vector<Real> > (const std::vector<Real>& v1)>(
                 ext::bind(
-                    &RecursiveLossModel::expectedConditionalLoss,
+                    &RecursiveLossModel::conditionalLossProbsInvP,
                     this,
-                    ext::cref(uncDefProb),
+                    ext::cref(invProbs),
                     _1)
                 )
             );
-            */
-/**/
-        using namespace ext::placeholders;
+        const Size nLosses = attainableLosses_.size();
+        for(Size iDate=0; iDate<outdated.size(); ++iDate)
+            outdated[iDate]->lossProb.assign(
+                lossProbs.begin() + iDate * nLosses, 
+                lossProbs.begin() + (iDate + 1) * nLosses);
+    }
 
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-        std::vector<Real> invProb;
-        for(Size i=0; i<uncDefProb.size(); ++i)
-           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
-           ///  invProb.push_back(CP::inverseCumulativeY(uncDefProb[i], i));//<-static call
-        return copula_->integratedExpectedValue(
-            ext::function<Real (const std::vector<Real>& v1)>(
-                ext::bind(
-                    &RecursiveLossModel::expectedConditionalLossInvP,
-                    this,
-                    ext::cref(invProb),
-                    _1)
-                )
-            );
-            
+    template<class CP>
+    inline const typename RecursiveLossModel<CP>::dateDistribution& 
+    RecursiveLossModel<CP>::distribution(const Date& date) const {
+        updateDistributions(std::vector<Date>(1, date));
+        return distributions_.find(date)->second;
     }
 
     template<class CP>
-    inline Disposable<std::vector<Real> > 
-    RecursiveLossModel<CP>::lossProbability(const Date& date) const {
+    inline Real RecursiveLossModel<CP>::expectedTrancheLossImpl(
+        const std::vector<Probability>& lossProb) const 
+    {
+        Real expLoss = 0.;
+        for(Size i=0; i<lossProb.size(); ++i) {
+            Real loss = attainableLosses_[i] * lossUnit_;
+            loss = std::min(std::max(loss - attachAmount_, 0.), 
+                detachAmount_ - attachAmount_);
+            expLoss += loss * lossProb[i];
+        }
+        return expLoss;
+    }
 
-        using namespace ext::placeholders;
+    template<class CP>
+    inline Real RecursiveLossModel<CP>::expectedTrancheLoss(
+        const Date& date) const 
+    {
+        return expectedTrancheLossImpl(distribution(date).lossProb);
+    }
 
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-        return copula_->integratedExpectedValue(
-            ext::function<Disposable<std::vector<Real> > (const std::vector<Real>& v1)>(
-                ext::bind(
-                    &RecursiveLossModel::conditionalLossProb,
-                    this,
-                    ext::cref(uncDefProb),
-                    _1)
-                )
-            );
+    template<class CP>
+    inline Disposable<std::vector<Real> > 
+    RecursiveLossModel<CP>::expectedTrancheLosses(
+        const std::vector<Date>& dates) const 
+    {
+        updateDistributions(dates);
+        std::vector<Real> losses(dates.size());
+        for(Size i=0; i<dates.size(); ++i)
+            losses[i] = expectedTrancheLossImpl(
+                distributions_.find(dates[i])->second.lossProb);
+        return losses;
+    }
+
+    template<class CP>
+    inline Disposable<std::vector<Real> > 
+    RecursiveLossModel<CP>::lossProbability(const Date& date) const {
+        std::vector<Real> lossProb = distribution(date).lossProb;
+        return lossProb;
     }
 
     // -------------------------------------------------------------------
@@ -230,8 +282,27 @@ namespace QuantLib {
         lgds.erase(std::remove(lgds.begin(), lgds.end(), 0.), lgds.end());
         lossUnit_ = *(std::min_element(lgds.begin(), lgds.end()))
             / nBuckets_;
+        std::vector<Size> wk(remainingBsktSize_);
         for(Size i=0; i<remainingBsktSize_; ++i)
-            wk_.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+            wk[i] = static_cast<Size>(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+
+        // The cached distributions are in loss units, they remain valid for
+        //   a basket with different tranche limits or loss unit as long as 
+        //   the loss weights are the same.
+        if(wk == wk_) return;
+        wk_.swap(wk);
+        distributions_.clear();
+
+        // attainable losses; sums of any subset of the names' losses
+        Size maxLoss = std::accumulate(wk_.begin(), wk_.end(), Size(0));
+        std::vector<bool> attainable(maxLoss+1, false);
+        attainable[0] = true;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            for(Size k=maxLoss+1; k-- > wk_[iName]; )
+                if(attainable[k - wk_[iName]]) attainable[k] = true;
+        attainableLosses_.clear();
+        for(Size k=0; k<=maxLoss; ++k)
+            if(attainable[k]) attainableLosses_.push_back(k);
     }
 
     // make it return a distribution object?
@@ -240,11 +311,11 @@ namespace QuantLib {
         RecursiveLossModel<CP>::lossDistribution(const Date& d) const 
     {
         std::map<Real, Probability> distrib;
-        std::vector<Real> values  = lossProbability(d);
+        const std::vector<Real>& values = distribution(d).lossProb;
         Real sum = 0.;
         for(Size i=0; i<values.size(); ++i) {
-            distrib.insert(std::make_pair<Real, Probability>(i * lossUnit_, 
-                sum + values[i]));
+            distrib.insert(std::make_pair<Real, Probability>(
+                attainableLosses_[i] * lossUnit_, sum + values[i]));
             sum += values[i];
         }
         return distrib;
@@ -321,202 +392,52 @@ namespace QuantLib {
         }
         return 0.;// well, we are in error....  fix: FAIL
     }
-
     template<class CP>
-    Disposable<std::map<Real, Probability> >
-        RecursiveLossModel<CP>::conditionalLossDistrib(
-            const std::vector<Probability>& pDefDate, 
-            //const Date& date,
-            const std::vector<Real>& mktFactor) const 
-    {
-        //eq. 10 p.68
-        //attainable losses distribution, recursive algorithm
-        const std::vector<Probability>& uncDefProb = pDefDate;// alias, remove
-
-        std::map<Real, Probability> pIndepDistrib;
-        ////////  K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
-        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbability(uncDefProb[iName], iName,
-                                                mktFactor);
-            ////// iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            std::map<Real, Probability>::iterator distIt =
-                pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-              ///   update prob if this name does not default
-                std::map<Real, Probability>::iterator matchIt
-                    = pDistTemp.find(distIt->first);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * (1.-pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-              ////   and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
-            }
-           /////  copy back
-            pIndepDistrib = pDistTemp;
-        }
-        /* Apply tranche limits now .... mind you this could be done outside*/
-        ////  to be done....
-        return pIndepDistrib;
-    }
-
-    template<class CP>
-    Disposable<std::map<Real, Probability> >
-        // twice?! rewrite one in terms of the other, this is a duplicate!
+    Disposable<std::vector<Probability> >
         RecursiveLossModel<CP>::conditionalLossDistribInvP(
             const std::vector<Real>& invpDefDate, 
-            //const Date& date,
             const std::vector<Real>& mktFactor) const 
     {
         // eq. 10 p.68
-        // attainable losses distribution, recursive algorithm
-
-        std::map<Real, Probability> pIndepDistrib;
+        // attainable losses distribution, recursive algorithm. Losses are 
+        //   integer multiples of the loss unit so the distribution is kept
+        //   in a dense vector and updated in place, from the top down.
+        std::vector<Probability> pIndepDistrib(
+            attainableLosses_.back() + 1, 0.);
         // K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
+        pIndepDistrib[0] = 1.;
+        Size topLoss = 0;
         for(Size iName=0; iName<remainingBsktSize_; ++iName) {
             Probability pDef =
                 copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
                     iName, mktFactor);
-
-            // iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            std::map<Real, Probability>::iterator distIt =
-                pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-                // update prob if this name does not default
-                std::map<Real, Probability>::iterator matchIt
-                    = pDistTemp.find(distIt->first);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * (1.-pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-                // and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
-            }
-            // copy back
-            pIndepDistrib = pDistTemp;
+            const Size w = wk_[iName];
+            topLoss += w;
+            // losses reached if this name defaults
+            for(Size k=topLoss+1; k-- > w; )
+                pIndepDistrib[k] = pIndepDistrib[k] * (1.-pDef) 
+                    + pIndepDistrib[k-w] * pDef;
+            // and those it can not reach
+            for(Size k=0; k<w && k<=topLoss; ++k)
+                pIndepDistrib[k] *= (1.-pDef);
         }
-        /* Apply tranche limits now .... mind you this could be done outside*/
         return pIndepDistrib;
     }
 
-
-
-
-    /*
-    Bugs here???. The max min on the tranche looks 
-    wrong. It is better to have a tranche function since that way we can avoid 
-    adding up losses over all the posible losses rather than just over the 
-    tranche limits.
-    */
-    //! Portfolio loss conditional to the market factor value
-    template<class CP>
-    Real RecursiveLossModel<CP>::expectedConditionalLoss(
-        const std::vector<Probability>& pDefDate, 
-        //const Date& date,
-        const std::vector<Real>& mktFactor) const 
-    {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistrib(pDefDate, mktFactor);
-
-        // get the expected value subject to the value of the market
-        //   factor.
-        Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        std::map<Real, Probability>::iterator distIt =
-            pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-     //       loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            loss = std::min(std::max(loss - attachAmount_, 0.), 
-                detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....??
-            expLoss += loss * distIt->second;
-            ++distIt;
-        }
-        return expLoss ;
-    }
-
     template<class CP>
-    // again, I am duplicating code.
-    Real RecursiveLossModel<CP>::expectedConditionalLossInvP(
-                                 const std::vector<Real>& invPDefDate, 
-                                 //const Date& date,
-                                 const std::vector<Real>& mktFactor) const 
-    {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistribInvP(invPDefDate, mktFactor);
-
-        // get the expected value subject to the value of the market
-        //   factor.
-        Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        std::map<Real, Probability>::iterator distIt =
-            pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-   //         loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            loss = std::min(std::max(loss - attachAmount_, 0.), 
-                detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....???
-            expLoss += loss * distIt->second;
-            ++distIt;
-        }
-        return expLoss ;
-    }
-
-    template<class CP>
-    Disposable<std::vector<Real> > RecursiveLossModel<CP>::conditionalLossProb(
-        const std::vector<Probability>& pDefDate, 
-        //const Date& date,
-        const std::vector<Real>& mktFactor) const 
+    Disposable<std::vector<Real> > 
+        RecursiveLossModel<CP>::conditionalLossProbsInvP(
+            const std::vector<std::vector<Real> >& invpDefDates, 
+            const std::vector<Real>& mktFactor) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistrib(pDefDate, mktFactor);
-
-        std::vector<Real> results;
-        std::map<Real, Probability>::iterator distIt = pIndepDistrib.begin();
-        while(distIt != pIndepDistrib.end()) {
-            //Real loss = distIt->first * loss_unit_
-            //                    ;
-            //loss = std::max(std::min(loss,
-            //    results_.xMax)-results_.xMin, 0.);
-            //expLoss += loss * distIt->second;
-
-            results.push_back(distIt->second);
-             ++distIt;
+        const Size nLosses = attainableLosses_.size();
+        std::vector<Real> results(invpDefDates.size() * nLosses);
+        for(Size iDate=0; iDate<invpDefDates.size(); ++iDate) {
+            std::vector<Probability> pIndepDistrib =
+                conditionalLossDistribInvP(invpDefDates[iDate], mktFactor);
+            for(Size i=0; i<nLosses; ++i)
+                results[iDate * nLosses + i] = 
+                    pIndepDistrib[attainableLosses_[i]];
         }
         return results;
     }
@@ -283,6 +283,9 @@ namespace QuantLib {
     public:
         Probability probOverPortfLoss(const Date& d, Real loss) const;
         Real expectedTrancheLoss(const Date& d) const;
+        //! Expected tranche losses on several dates in one integration.
+        Disposable<std::vector<Real> > expectedTrancheLosses(
+            const std::vector<Date>& dates) const;
     protected:
         /*!
         Probability density of having losses in the total portfolio (untranched)
@@ -332,6 +335,10 @@ namespace QuantLib {
         Real conditionalExpectedTrancheLoss(
             const std::vector<Real>& invUncondProbs,
             const std::vector<Real>& mktFactor) const;
+        //! Conditional expected tranche losses on several dates.
+        Disposable<std::vector<Real> > conditionalExpectedTrancheLosses(
+            const std::vector<std::vector<Real> >& invUncondProbs,
+            const std::vector<Real>& mktFactor) const;
 
         void resetModel() {
             remainingNotionals_ = basket_->remainingNotionals();
@@ -577,6 +584,34 @@ namespace QuantLib {
             );
     }
 
+    template<class CP>
+    inline Disposable<std::vector<Real> > 
+    SaddlePointLossModel<CP>::expectedTrancheLosses(
+        const std::vector<Date>& dates) const 
+    {
+        using namespace ext::placeholders;
+
+        std::vector<std::vector<Real> > invUncondProbs;
+        for(Size iDate=0; iDate<dates.size(); iDate++) {
+            invUncondProbs.push_back(
+                basket_->remainingProbabilities(dates[iDate]));
+            std::vector<Real>& invProbs = invUncondProbs.back();
+            for(Size i=0; i<invProbs.size(); i++)
+                invProbs[i] = copula_->inverseCumulativeY(invProbs[i], i);
+        }
+
+        return copula_->integratedExpectedValue(
+            ext::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>& v1)>(
+                ext::bind(
+                    &SaddlePointLossModel<CP>::conditionalExpectedTrancheLosses,
+                    this,
+                    ext::cref(invUncondProbs),
+                    _1)
+                )
+            );
+    }
+
     template<class CP>
     inline Probability SaddlePointLossModel<CP>::probDensity(
         const Date& d, Real loss) const 
@@ -1253,6 +1288,19 @@ namespace QuantLib {
         return eloss;
     }
 
+    template<class CP>
+    Disposable<std::vector<Real> > 
+    SaddlePointLossModel<CP>::conditionalExpectedTrancheLosses(
+        const std::vector<std::vector<Real> >& invUncondProbs,
+        const std::vector<Real>& mktFactor) const 
+    {
+        std::vector<Real> losses(invUncondProbs.size());
+        for(Size iDate=0; iDate<invUncondProbs.size(); iDate++)
+            losses[iDate] = 
+                conditionalExpectedTrancheLoss(invUncondProbs[iDate], mktFactor);
+        return losses;
+    }
+
     template<class CP>
     Real SaddlePointLossModel<CP>::conditionalExpectedTrancheLoss(
         const std::vector<Real>& invUncondProbs,
@@ -103,6 +103,13 @@ namespace QuantLib {
         */
         Real conditionalRecovery(Real latentVarSample, Size iName, 
             const Date& d) const;
+        /*! As above, given the unconditional default probability of the
+            name and the copula to be used; the latter allows callers
+            running on several threads to work on their own copy of it.
+        */
+        Real conditionalRecoveryP(Probability uncondDefP,
+            Real latentVarSample, Size iName,
+            const copulaPolicy& copula) const;
         /*! Due to the way the latent model is splitted in two parts, we call 
         the base class for the default sample and the LM owned here for the RR 
         model sample. This sample only makes sense if it led to a default.
@@ -264,18 +271,27 @@ namespace QuantLib {
             pool->get(basket_->names()[iName]).defaultProbability(
                 basket_->defaultKeys()[iName]);
         const Probability pdef = dfts->defaultProbability(d, true);
+        return conditionalRecoveryP(pdef, latentVarSample, iName,
+            this->copula());
+    }
+
+    template<class CP>
+    Real SpotRecoveryLatentModel<CP>::conditionalRecoveryP(
+        Probability uncondDefP, Real latentVarSample, Size iName,
+        const CP& copula) const
+    {
         // before asking for -\infty
-        if (pdef < 1.e-10) return 0.;
+        if (uncondDefP < 1.e-10) return 0.;
 
         Size iRecovery = iName + numNames_;// should be live pool
-        return cumulativeY(
+        return copula.cumulativeY(
             (latentVarSample - std::sqrt(crossIdiosyncFctrs_[iName]) 
-                * inverseCumulativeY(pdef, iName)) / 
+                * copula.inverseCumulativeY(uncondDefP, iName)) / 
                 (modelA_ * std::sqrt(1.-crossIdiosyncFctrs_[iName]))
             // cache the sqrts
             // cache this factor.
             +std::sqrt(1.+ 1./(modelA_*modelA_)) * 
-                inverseCumulativeY(recoveries_[iName], iRecovery) 
+                copula.inverseCumulativeY(recoveries_[iName], iRecovery) 
             , iRecovery);
     }
 
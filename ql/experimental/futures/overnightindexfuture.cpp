@@ -52,8 +52,7 @@ namespace QuantLib {
             today = calendar_.adjust(today, businessDayConvention_);
             // for valuations inside the reference period, index quotes
             // must have been populated in the history
-            const TimeSeries<Real>& history = IndexManager::instance()
-                .getHistory(overnightIndex_->name());
+            const FixingHistory& history = *overnightIndex_->fixingHistory();
             Date d1 = valueDate_;
             while (d1 < today) {
                 Real r = history[d1];
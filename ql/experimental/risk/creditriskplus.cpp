@@ -18,6 +18,8 @@
 */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
 #include <map>
 
 using std::sqrt;
@@ -29,10 +31,10 @@ namespace QuantLib {
         const std::vector<Real> &defaultProbability,
         const std::vector<Size> &sector,
         const std::vector<Real> &relativeDefaultVariance,
-        const Matrix &correlation, const Real unit)
+        const Matrix &correlation, const Real unit, Algorithm algorithm)
         : exposure_(exposure), pd_(defaultProbability), sector_(sector),
           relativeDefaultVariance_(relativeDefaultVariance),
-          correlation_(correlation), unit_(unit) {
+          correlation_(correlation), unit_(unit), algorithm_(algorithm) {
 
         m_ = exposure_.size();
 
@@ -210,26 +212,57 @@ namespace QuantLib {
         Real betaC_ = sigmaC_ * sigmaC_ / pdSum_;
         Real pC_ = betaC_ / (1.0 + betaC_);
 
+        // exposure bands, only those present in the portfolio, ascending
+
+        std::vector<std::pair<unsigned long, Real> > bands(epsNuC_.begin(),
+                                                           epsNuC_.end());
+
         // compute loss distribution
 
         loss_.clear();
-        loss_.push_back(std::pow(1.0 - pC_, alphaC_)); // A(0)
-
-        Real res;
-        for (unsigned long n = 0; n < upperIndex_ - 1; ++n) { // compute A(n+1)
-                                                              // recursively
-            res = 0.0;
-            for (unsigned long j = 0;
-                 j <= std::min<unsigned long>(maxNu_ - 1, n); ++j) {
-                iter = epsNuC_.find(j + 1);
-                if (iter != epsNuC_.end()) {
-                    res += (*iter).second * loss_[n - j] * alphaC_;
+
+        if (algorithm_ == FourierTransform) {
+
+            // severity distribution of a single default in loss units
+            std::vector<Real> severity(maxNu_ + 1, 0.0);
+            for (Size b = 0; b < bands.size(); ++b)
+                severity[bands[b].first] =
+                    bands[b].second / (bands[b].first * pdSum_);
+
+            // probability generating function on the unit roots
+            FastFourierTransform fft(
+                FastFourierTransform::min_order(2 * upperIndex_));
+            const long gridSize = static_cast<long>(fft.output_size());
+            std::vector<std::complex<Real> > pgf(gridSize), density(gridSize);
+            fft.transform(severity.begin(), severity.end(), pgf.begin());
+
+            #pragma omp parallel for
+            for (long k = 0; k < gridSize; ++k)
+                pgf[k] = std::pow((1.0 - pC_) / (1.0 - pC_ * pgf[k]), alphaC_);
+
+            fft.inverse_transform(pgf.begin(), pgf.end(), density.begin());
+            loss_.resize(upperIndex_);
+            for (unsigned long n = 0; n < upperIndex_; ++n)
+                loss_[n] = std::max(density[n].real() / gridSize, 0.0);
+
+        } else {
+
+            loss_.push_back(std::pow(1.0 - pC_, alphaC_)); // A(0)
+
+            Real res;
+            for (unsigned long n = 0; n < upperIndex_ - 1; ++n) { // compute A(n+1)
+                                                                  // recursively
+                res = 0.0;
+                for (Size b = 0; b < bands.size() && bands[b].first <= n + 1;
+                     ++b) {
+                    unsigned long j = bands[b].first - 1;
+                    res += bands[b].second * loss_[n - j] * alphaC_;
                     if (j <= n - 1)
-                        res += (*iter).second / ((Real)(j + 1)) *
+                        res += bands[b].second / ((Real)(j + 1)) *
                                ((Real)(n - j)) * loss_[n - j];
                 }
+                loss_.push_back(res * pC_ / (pdSum_ * ((Real)(n + 1))));
             }
-            loss_.push_back(res * pC_ / (pdSum_ * ((Real)(n + 1))));
         }
     }
 }
@@ -34,6 +34,14 @@ namespace QuantLib {
     /*! Extended CreditRisk+ model as described in [1] Integrating Correlations, Risk,
       July 1999 and the references therein.
 
+      The loss distribution is computed either by the Panjer recursion
+      or by inverting its probability generating function with a fast
+      Fourier transform. The recursion costs the number of exposure bands
+      per loss unit, the transform n log n in the number of loss units,
+      which makes the latter preferable for large portfolios measured in
+      fine units. The transform is evaluated on a grid of twice the
+      maximum loss, the tail beyond it is aliased onto the distribution.
+
       \warning the input correlation matrix is not checked for positive
       definiteness
 
@@ -43,11 +51,14 @@ namespace QuantLib {
 
       public:
 
+        enum Algorithm { PanjerRecursion, FourierTransform };
+
         CreditRiskPlus(const std::vector<Real> &exposure,
                        const std::vector<Real> &defaultProbability,
                        const std::vector<Size> &sector,
                        const std::vector<Real> &relativeDefaultVariance,
-                       const Matrix &correlation, const Real unit);
+                       const Matrix &correlation, const Real unit,
+                       Algorithm algorithm = PanjerRecursion);
 
         const std::vector<Real> &loss() { return loss_; }
         const std::vector<Real> &marginalLoss() { return marginalLoss_; }
@@ -80,6 +91,7 @@ namespace QuantLib {
         const std::vector<Real> relativeDefaultVariance_;
         const Matrix correlation_;
         const Real unit_;
+        const Algorithm algorithm_;
 
         Size n_, m_; // number of sectors, exposures
 
@@ -20,12 +20,223 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <map>
+#include <string>
 
 using std::vector;
 using std::pair;
 
 namespace QuantLib {
 
+    namespace {
+
+        typedef vector<vector<Real> > Scenarios;
+
+        // base scenario followed by the up (and down) bump of each quote
+        Scenarios bucketScenarios(Size nQuotes, Real shift,
+                                  SensitivityAnalysis type) {
+            QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+            Size bumps;
+            switch (type) {
+              case OneSide:
+                bumps = 1;
+                break;
+              case Centered:
+                bumps = 2;
+                break;
+              default:
+                QL_FAIL("unknown SensitivityAnalysis (" <<
+                        Integer(type) << ")");
+            }
+            Scenarios scenarios(1+bumps*nQuotes, vector<Real>(nQuotes, 0.0));
+            for (Size i=0; i<nQuotes; ++i) {
+                scenarios[1+bumps*i][i] = shift;
+                if (bumps == 2)
+                    scenarios[2+bumps*i][i] = -shift;
+            }
+            return scenarios;
+        }
+
+        pair<Matrix, Matrix> bucketResults(const Matrix& npvs,
+                                           Size nQuotes, Real shift,
+                                           SensitivityAnalysis type) {
+            Size n = npvs.rows();
+            pair<Matrix, Matrix> result(Matrix(n, nQuotes, 0.0),
+                                        Matrix(n, nQuotes, 0.0));
+            for (Size k=0; k<n; ++k) {
+                Real npv = npvs[k][0];
+                for (Size i=0; i<nQuotes; ++i) {
+                    if (type == OneSide) {
+                        result.first[k][i] = (npvs[k][1+i]-npv)/shift;
+                        result.second[k][i] = Null<Real>();
+                    } else {
+                        Real up = npvs[k][1+2*i], down = npvs[k][2+2*i];
+                        result.first[k][i] = (up-down)/(2.0*shift);
+                        result.second[k][i] =
+                            (up-2.0*npv+down)/(shift*shift);
+                    }
+                }
+            }
+            return result;
+        }
+
+        void checkScenarios(const Scenarios& scenarios, Size nQuotes) {
+            for (Size s=0; s<scenarios.size(); ++s)
+                QL_REQUIRE(scenarios[s].size()==nQuotes,
+                           "scenario #" << s << " has " <<
+                           scenarios[s].size() << " shifts, " <<
+                           nQuotes << " quotes given");
+        }
+
+        void evaluateScenario(
+                      const vector<Handle<SimpleQuote> >& quotes,
+                      const vector<Real>& quoteValues,
+                      const vector<ext::shared_ptr<Instrument> >& instruments,
+                      const vector<Real>& scenario,
+                      Matrix& npvs, Size column) {
+            Size n = quotes.size();
+            try {
+                for (Size i=0; i<n; ++i)
+                    if (scenario[i]!=0.0 && quoteValues[i]!=Null<Real>())
+                        quotes[i]->setValue(quoteValues[i]+scenario[i]);
+                for (Size k=0; k<instruments.size(); ++k)
+                    npvs[k][column] = instruments[k]->NPV();
+                for (Size i=0; i<n; ++i)
+                    if (scenario[i]!=0.0 && quoteValues[i]!=Null<Real>())
+                        quotes[i]->setValue(quoteValues[i]);
+            } catch (...) {
+                for (Size i=0; i<n; ++i)
+                    if (quoteValues[i]!=Null<Real>())
+                        quotes[i]->setValue(quoteValues[i]);
+                throw;
+            }
+        }
+
+        vector<Real> currentValues(
+                            const vector<Handle<SimpleQuote> >& quotes) {
+            vector<Real> values(quotes.size(), Null<Real>());
+            for (Size i=0; i<quotes.size(); ++i)
+                if (quotes[i]->isValid())
+                    values[i] = quotes[i]->value();
+            return values;
+        }
+
+        // records the owner of each quote and instrument of a copy and
+        // checks that no other copy returned the same objects
+        void checkIndependentCopy(
+                        const vector<Handle<SimpleQuote> >& quotes,
+                        const vector<ext::shared_ptr<Instrument> >& instr,
+                        const void* owner,
+                        std::map<const void*, const void*>& owners) {
+            for (Size i=0; i<quotes.size()+instr.size(); ++i) {
+                const void* object = i < quotes.size() ?
+                    static_cast<const void*>(quotes[i].currentLink().get()) :
+                    static_cast<const void*>(
+                                        instr[i-quotes.size()].get());
+                const void* previous =
+                    owners.insert(std::make_pair(object, owner)).first->second;
+                QL_REQUIRE(previous == owner,
+                           "portfolio builder returned " <<
+                           (i < quotes.size() ? "quotes" : "instruments") <<
+                           " shared among copies");
+            }
+        }
+
+        /* The scenarios can be given explicitly or, when null,
+           generated as bucket bumps once the number of quotes is known.
+
+           Each thread builds, bumps and releases its own copy of the
+           portfolio.  The three phases are separated by barriers, so
+           that building and releasing the copies, which register with
+           and unregister from global observables, never run alongside
+           the evaluation of the scenarios.
+        */
+        Matrix parallelScenarioNPVs(const SensitivityPortfolioBuilder& builder,
+                                    const Scenarios* givenScenarios,
+                                    Real shift, SensitivityAnalysis type,
+                                    Size& nQuotes) {
+            Scenarios scenarios;
+            Matrix npvs;
+            Size nInstruments = 0;
+            bool built = false;
+            std::string buildError, scenarioError;
+            std::map<const void*, const void*> owners;
+
+            #pragma omp parallel
+            {
+                vector<Handle<SimpleQuote> > quotes;
+                vector<ext::shared_ptr<Instrument> > instruments;
+
+                // builders register with global observables (e.g., the
+                // evaluation date) which are not thread-safe
+                #pragma omp critical(ql_sensitivity_portfolio)
+                {
+                    try {
+                        builder(quotes, instruments);
+                        if (!built) {
+                            nQuotes = quotes.size();
+                            nInstruments = instruments.size();
+                            if (givenScenarios != 0) {
+                                checkScenarios(*givenScenarios, nQuotes);
+                                scenarios = *givenScenarios;
+                            } else {
+                                scenarios =
+                                    bucketScenarios(nQuotes, shift, type);
+                            }
+                            npvs = Matrix(nInstruments, scenarios.size());
+                            built = true;
+                        } else {
+                            QL_REQUIRE(quotes.size() == nQuotes &&
+                                       instruments.size() == nInstruments,
+                                       "portfolio builder returned "
+                                       "inconsistent copies");
+                        }
+                        checkIndependentCopy(quotes, instruments,
+                                             &quotes, owners);
+                    } catch (std::exception& e) {
+                        if (buildError.empty())
+                            buildError = e.what();
+                    }
+                }
+
+                #pragma omp barrier
+
+                const long nScenarios =
+                    buildError.empty() ? long(scenarios.size()) : 0;
+                const vector<Real> quoteValues =
+                    buildError.empty() ? currentValues(quotes)
+                                       : vector<Real>();
+
+                // the implicit barrier at the end of the loop keeps the
+                // copies alive until all scenarios are evaluated
+                #pragma omp for schedule(dynamic)
+                for (long s=0; s<nScenarios; ++s) {
+                    try {
+                        evaluateScenario(quotes, quoteValues, instruments,
+                                         scenarios[s], npvs, s);
+                    } catch (std::exception& e) {
+                        #pragma omp critical(ql_sensitivity_error)
+                        {
+                            if (scenarioError.empty())
+                                scenarioError = e.what();
+                        }
+                    }
+                }
+
+                #pragma omp critical(ql_sensitivity_portfolio)
+                {
+                    instruments.clear();
+                    quotes.clear();
+                }
+            }
+
+            QL_REQUIRE(buildError.empty(), buildError);
+            QL_REQUIRE(scenarioError.empty(), scenarioError);
+            return npvs;
+        }
+
+    }
+
     std::ostream& operator<<(std::ostream& out,
                              SensitivityAnalysis s) {
         switch (s) {
@@ -350,4 +561,45 @@ namespace QuantLib {
         return result;
     }
 
+    Matrix scenarioNPVs(const vector<Handle<SimpleQuote> >& quotes,
+                        const vector<ext::shared_ptr<Instrument> >& instr,
+                        const vector<vector<Real> >& scenarios) {
+        checkScenarios(scenarios, quotes.size());
+        Matrix npvs(instr.size(), scenarios.size());
+        vector<Real> quoteValues = currentValues(quotes);
+        for (Size s=0; s<scenarios.size(); ++s)
+            evaluateScenario(quotes, quoteValues, instr, scenarios[s],
+                             npvs, s);
+        return npvs;
+    }
+
+    Matrix scenarioNPVs(const SensitivityPortfolioBuilder& builder,
+                        const vector<vector<Real> >& scenarios) {
+        Size nQuotes;
+        return parallelScenarioNPVs(builder, &scenarios, Null<Real>(),
+                                    Centered, nQuotes);
+    }
+
+    pair<Matrix, Matrix>
+    bucketSensitivities(const vector<Handle<SimpleQuote> >& quotes,
+                        const vector<ext::shared_ptr<Instrument> >& instr,
+                        Real shift,
+                        SensitivityAnalysis type) {
+        QL_REQUIRE(!quotes.empty(), "empty SimpleQuote vector");
+        Size n = quotes.size();
+        Matrix npvs =
+            scenarioNPVs(quotes, instr, bucketScenarios(n, shift, type));
+        return bucketResults(npvs, n, shift, type);
+    }
+
+    pair<Matrix, Matrix>
+    bucketSensitivities(const SensitivityPortfolioBuilder& builder,
+                        Real shift,
+                        SensitivityAnalysis type) {
+        Size nQuotes = 0;
+        Matrix npvs = parallelScenarioNPVs(builder, 0, shift, type, nQuotes);
+        QL_REQUIRE(nQuotes != 0, "empty SimpleQuote vector");
+        return bucketResults(npvs, nQuotes, shift, type);
+    }
+
 }
@@ -27,6 +27,8 @@
 #include <ql/types.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/functional.hpp>
+#include <ql/math/matrix.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -175,6 +177,65 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! builds the quotes to be bumped and the instruments depending on them
+    /*! Each call must return an independent copy of the same market and
+        portfolio, so that copies can be bumped concurrently: quotes,
+        term structures, indexes, pricers and engines must be created
+        anew at each call, and only objects which are never modified
+        (e.g., calendars or day counters) can be shared.  Returning the
+        same quotes or instruments from different calls is detected
+        and reported as an error; objects shared further down the
+        graph can't be detected and must be avoided.
+    */
+    typedef ext::function<void(std::vector<Handle<SimpleQuote> >&,
+                               std::vector<ext::shared_ptr<Instrument> >&)>
+        SensitivityPortfolioBuilder;
+
+    //! NPV of each instrument under a set of quote scenarios
+    /*! Each scenario holds the shift to apply to each quote; zero shifts
+        and invalid quotes are left untouched. Quotes are restored after
+        each scenario. Returns a matrix with one row for each instrument
+        and one column for each scenario.
+    */
+    Matrix scenarioNPVs(const std::vector<Handle<SimpleQuote> >&,
+                        const std::vector<ext::shared_ptr<Instrument> >&,
+                        const std::vector<std::vector<Real> >& scenarios);
+
+    //! NPV of each instrument under a set of quote scenarios, in parallel
+    /*! As above, but the scenarios are shared among the available threads
+        when OpenMP is enabled. Every thread calls the builder once and
+        bumps its own copy of the market; the builder calls and the
+        destruction of the copies are serialized since they register with
+        global observables such as the evaluation date, and no scenario
+        is evaluated while they run.  The results are the same as those
+        of the serial version on a single copy.
+    */
+    Matrix scenarioNPVs(const SensitivityPortfolioBuilder&,
+                        const std::vector<std::vector<Real> >& scenarios);
+
+    //! bucket sensitivities of each instrument for a SimpleQuote vector
+    /*! returns a pair of first and second derivative matrices with one row
+        for each instrument and one column for each quote, calculated as
+        prescribed by SensitivityAnalysis. Second derivatives are null for
+        OneSide.
+
+        The (bucket) SimpleQuotes are tweaked one by one separately.
+    */
+    std::pair<Matrix, Matrix>
+    bucketSensitivities(const std::vector<Handle<SimpleQuote> >&,
+                        const std::vector<ext::shared_ptr<Instrument> >&,
+                        Real shift = 0.0001,
+                        SensitivityAnalysis type = Centered);
+
+    //! bucket sensitivities of each instrument, in parallel
+    /*! As above, with the bumps evaluated as in the parallel version of
+        scenarioNPVs.
+    */
+    std::pair<Matrix, Matrix>
+    bucketSensitivities(const SensitivityPortfolioBuilder&,
+                        Real shift = 0.0001,
+                        SensitivityAnalysis type = Centered);
+
 }
 
 #endif
@@ -37,10 +37,19 @@ QuantLib::Real secondElement(const std::pair< QuantLib::Date, QuantLib::Real > &
 namespace QuantLib {
 
 //! Multi curve sensitivities
-/*! This class provides a simple (yet most likely not the fastest) way to create sensitivities
-  to the <em>par quotes</em>, provided in the piecewiseyieldcurve for stripping. If constructed with more
-than one curve, the class iterates over all quotes of the provided curves and shifts each quote of all provided curves
-taking interdependence into account.
+/*! This class provides sensitivities to the <em>par quotes</em>, provided in the piecewiseyieldcurve
+for stripping. If constructed with more than one curve, the interdependence of the curves is taken into account.
+
+Rather than shifting each quote and bootstrapping all curves again, the class shifts each node of the bootstrapped
+curves in turn (by means of PiecewiseYieldCurve::setNodeValue, which notifies the observers of the curve) and
+reprices all helpers on the unchanged remaining nodes. This yields the Jacobian
+\f$ \partial q_j / \partial z_i \f$ of the implied quotes, i.e., the inverse sensitivities; since the bootstrap
+solves \f$ q_j(z) = \bar{q}_j \f$ for all helpers, the implicit-function theorem gives the sensitivities as its
+inverse. The results are the same as those obtained by shifting the quotes, up to the accuracy of the bootstrap and
+of the finite differences.
+
+During the calculation, the curves are frozen so that the shift of a node doesn't cause the curves depending on it
+to be bootstrapped again; they are unfrozen afterwards.
 
 The class computes the sensitvities as a QuantLib Matrix class in the form:
 \f[
@@ -65,7 +74,7 @@ public:
   /*! @param curves std::map of string (curve name) and handle to piecewiseyieldcurve
   */
 
-  explicit MultiCurveSensitivities(const curvespec& curves) : curves_(curves) {
+  explicit MultiCurveSensitivities(const curvespec& curves) : curves_(curves), shifting_(false) {
     for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it)
       registerWith((*it).second);
     for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
@@ -75,6 +84,7 @@ public:
       for (std::vector< ext::shared_ptr< BootstrapHelper< YieldTermStructure > > >::iterator inst =
                curve->instruments_.begin();
            inst != curve->instruments_.end(); ++inst) {
+        allHelpers_.push_back(*inst);
         allQuotes_.push_back((*inst)->quote());
         std::stringstream tmp;
         tmp << QuantLib::io::iso_date((*inst)->latestRelevantDate());
@@ -87,43 +97,84 @@ public:
   Matrix inverseSensitivities() const;
   std::vector< std::string > headers() const { return headers_; }
 
+  //! \name Observer interface
+  //@{
+  void update();
+  //@}
+
 private:
   //! \name LazyObject interface
   //@{
   void performCalculations() const;
   //@}
+  typedef PiecewiseYieldCurve< ZeroYield, Linear > curve_type;
   // methods
   std::vector< Real > allZeros() const;
   std::vector< std::pair< Date, Real > > allNodes() const;
+  std::vector< Real > allImpliedQuotes() const;
   mutable std::vector< Rate > origZeros_;
+  std::vector< ext::shared_ptr< BootstrapHelper< YieldTermStructure > > > allHelpers_;
   std::vector< Handle< Quote > > allQuotes_;
   std::vector< std::pair< Date, Real > > origNodes_;
   mutable Matrix sensi_, invSensi_;
   curvespec curves_;
   std::vector< std::string > headers_;
+  // set while the curve nodes are shifted
+  mutable bool shifting_;
 };
 
+inline void MultiCurveSensitivities::update() {
+  // the notifications sent by the curves while their nodes are shifted are ignored
+  if (!shifting_)
+    LazyObject::update();
+}
+
 inline void MultiCurveSensitivities::performCalculations() const {
-  std::vector< Rate > sensiVector;
+  // bootstraps all curves
   origZeros_ = allZeros();
-  for (std::vector< Handle< Quote > >::const_iterator it = allQuotes_.begin(); it != allQuotes_.end(); ++it) {
-    Rate bps = +1e-4;
-    Rate origQuote = (*it)->value();
-    ext::shared_ptr< SimpleQuote > q = ext::dynamic_pointer_cast< SimpleQuote >((*it).currentLink());
-    q->setValue(origQuote + bps);
-    try {
-      std::vector< Rate > tmp(allZeros());
-      for (Size i = 0; i < tmp.size(); ++i)
-        sensiVector.push_back((tmp[i] - origZeros_[i]) / bps);
-      q->setValue(origQuote);
-    } catch (...) {
-      q->setValue(origQuote);
-      QL_FAIL("Application of shift to quote led to exception.");
+  Size n = origZeros_.size();
+  QL_REQUIRE(n == allHelpers_.size(),
+             "number of curve nodes (" << n << ") different from number of helpers (" << allHelpers_.size() << ")");
+
+  std::vector< ext::shared_ptr< curve_type > > curves;
+  std::vector< std::vector< Real > > origData;
+  for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
+    curves.push_back(ext::dynamic_pointer_cast< curve_type >(it->second.currentLink()));
+    origData.push_back(curves.back()->data());
+  }
+
+  // row i holds the derivatives of the implied quotes with respect to the i-th zero
+  Rate bps = +1e-4;
+  invSensi_ = Matrix(n, n);
+  shifting_ = true;
+  for (Size c = 0; c < curves.size(); ++c)
+    curves[c]->freeze();
+  try {
+    Size i = 0;
+    for (Size c = 0; c < curves.size(); ++c) {
+      for (Size k = 1; k < origData[c].size(); ++k, ++i) {
+        curves[c]->setNodeValue(k, origData[c][k] + bps);
+        std::vector< Real > up = allImpliedQuotes();
+        curves[c]->setNodeValue(k, origData[c][k] - bps);
+        std::vector< Real > down = allImpliedQuotes();
+        curves[c]->setNodeValue(k, origData[c][k]);
+        for (Size j = 0; j < n; ++j)
+          invSensi_[i][j] = (up[j] - down[j]) / (2.0 * bps);
+      }
     }
+  } catch (...) {
+    for (Size c = 0; c < curves.size(); ++c) {
+      for (Size k = 1; k < origData[c].size(); ++k)
+        curves[c]->setNodeValue(k, origData[c][k]);
+      curves[c]->unfreeze();
+    }
+    shifting_ = false;
+    QL_FAIL("Application of shift to curve node led to exception.");
   }
-  Matrix result(origZeros_.size(), origZeros_.size(), sensiVector.begin(), sensiVector.end());
-  sensi_ = result;
-  invSensi_ = inverse(sensi_);
+  for (Size c = 0; c < curves.size(); ++c)
+    curves[c]->unfreeze();
+  shifting_ = false;
+  sensi_ = inverse(invSensi_);
 }
 
 inline Matrix MultiCurveSensitivities::sensitivities() const {
@@ -141,13 +192,21 @@ inline std::vector< std::pair< Date, Real > > MultiCurveSensitivities::allNodes(
   for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
     ext::shared_ptr< PiecewiseYieldCurve< ZeroYield, Linear > > curve =
         ext::dynamic_pointer_cast< PiecewiseYieldCurve< ZeroYield, Linear > >(it->second.currentLink());
-    result.reserve(result.size() + curve->nodes().size() - 1);
-    for (std::vector<std::pair<Date, Real> >::const_iterator p = curve->nodes().begin() + 1; p != curve->nodes().end(); ++p)
-      result.push_back(*p);
+    // nodes() returns a copy
+    std::vector< std::pair< Date, Real > > nodes = curve->nodes();
+    result.insert(result.end(), nodes.begin() + 1, nodes.end());
   }
   return result;
 }
 
+inline std::vector< Real > MultiCurveSensitivities::allImpliedQuotes() const {
+  std::vector< Real > quotes;
+  quotes.reserve(allHelpers_.size());
+  for (Size j = 0; j < allHelpers_.size(); ++j)
+    quotes.push_back(allHelpers_[j]->impliedQuote());
+  return quotes;
+}
+
 inline std::vector< Real > MultiCurveSensitivities::allZeros() const {
   std::vector< std::pair< Date, Real > > result = allNodes();
   std::vector< Real > zeros;
@@ -42,6 +42,17 @@ namespace QuantLib {
                    forceOverwrite);
     }
 
+    ext::shared_ptr<FixingHistory> Index::fixingHistory() const {
+        #if defined(QL_ENABLE_SESSIONS)
+        // the repository depends on the session; don't keep it
+        return IndexManager::instance().registerHistory(name());
+        #else
+        if (!fixingHistory_)
+            fixingHistory_ = IndexManager::instance().registerHistory(name());
+        return fixingHistory_;
+        #endif
+    }
+
     void Index::clearFixings() {
         checkNativeFixingsAllowed();
         IndexManager::instance().clearHistory(name());
@@ -30,6 +30,7 @@
 #include <ql/time/calendar.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/indexes/indexmanager.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -62,8 +63,15 @@ namespace QuantLib {
                             bool forecastTodaysFixing = false) const = 0;
         //! returns the fixing TimeSeries
         const TimeSeries<Real>& timeSeries() const {
-            return IndexManager::instance().getHistory(name());
+            return fixingHistory()->timeSeries();
         }
+        //! returns the stored fixings
+        /*! The history is registered in the IndexManager on first
+            access and kept afterwards; retrieving a past fixing
+            through it doesn't require any search.  When sessions are
+            enabled, the history is looked up at each call instead.
+        */
+        ext::shared_ptr<FixingHistory> fixingHistory() const;
         //! check if index allows for native fixings.
         /*! If this returns false, calls to addFixing and similar
             methods will raise an exception.
@@ -91,8 +99,11 @@ namespace QuantLib {
                         ValueIterator vBegin,
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
-            std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            const ext::shared_ptr<FixingHistory> h = fixingHistory();
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            // positions of the dates already in the batch
+            std::map<Date, Size> pending;
             bool noInvalidFixing = true, noDuplicatedFixing = true;
             Date invalidDate, duplicatedDate;
             Real nullValue = Null<Real>();
@@ -100,12 +111,19 @@ namespace QuantLib {
             Real duplicatedValue = Null<Real>();
             while (dBegin != dEnd) {
                 bool validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
+                std::map<Date, Size>::const_iterator p = pending.find(*dBegin);
+                Real currentValue =
+                    p != pending.end() ? values[p->second] : (*h)[*dBegin];
                 bool missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
-                    if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
-                    else if (close(currentValue,*(vBegin))) {
+                    if (missingFixing && p != pending.end()) {
+                        values[p->second] = *(vBegin++);
+                        ++dBegin;
+                    } else if (missingFixing) {
+                        pending[*dBegin] = dates.size();
+                        dates.push_back(*(dBegin++));
+                        values.push_back(*(vBegin++));
+                    } else if (close(currentValue,*(vBegin))) {
                         ++dBegin;
                         ++vBegin;
                     } else {
@@ -119,7 +137,7 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            h->add(dates.begin(), dates.end(), values.begin());
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
@@ -127,7 +145,7 @@ namespace QuantLib {
             QL_REQUIRE(noDuplicatedFixing,
                        "At least one duplicated fixing provided: " <<
                        duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
+                       " while " << (*h)[duplicatedDate] <<
                        " value is already present");
         }
         //! clears all stored historical fixings
@@ -135,6 +153,7 @@ namespace QuantLib {
       private:
         //! check if index allows for native fixings
         void checkNativeFixingsAllowed();
+        mutable ext::shared_ptr<FixingHistory> fixingHistory_;
     };
 
 }
@@ -2,6 +2,8 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/indexes/bmaindex.hpp>
+#include <ql/indexes/fixingfile.hpp>
+#include <ql/indexes/fixinghistory.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/indexes/inflationindex.hpp>
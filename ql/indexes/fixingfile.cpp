@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixingfile.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
+#include <fstream>
+
+namespace QuantLib {
+
+    namespace {
+
+        const char magic[8] = { 'Q','L','F','I','X','I','N','G' };
+        const boost::uint32_t version = 1;
+        const Size headerSize = 32;
+        const Size entrySize = 48;
+
+        struct Entry {
+            boost::uint64_t nameOffset, nameLength;
+            boost::int64_t firstSerial;
+            boost::uint64_t length, size, dataOffset;
+        };
+
+        template <class T>
+        void writeValue(std::ofstream& out, T x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        T readValue(const char* p) {
+            T x;
+            std::memcpy(&x, p, sizeof(T));
+            return x;
+        }
+
+        boost::uint64_t align(boost::uint64_t offset) {
+            return (offset + sizeof(Real) - 1) / sizeof(Real) * sizeof(Real);
+        }
+
+    }
+
+    void saveFixingFile(const std::string& fileName,
+                        const std::vector<std::string>& indexNames) {
+        IndexManager& manager = IndexManager::instance();
+
+        std::vector<std::string> names;
+        std::vector<ext::shared_ptr<FixingHistory> > histories;
+        for (Size i=0; i<indexNames.size(); ++i) {
+            if (manager.hasHistory(indexNames[i])) {
+                names.push_back(indexNames[i]);
+                histories.push_back(manager.fixingHistory(indexNames[i]));
+            }
+        }
+
+        // lay out names and data after the table
+        std::vector<Entry> entries(names.size());
+        boost::uint64_t offset = headerSize + entrySize*names.size();
+        for (Size i=0; i<names.size(); ++i) {
+            entries[i].nameOffset = offset;
+            entries[i].nameLength = names[i].size();
+            offset += names[i].size();
+        }
+        for (Size i=0; i<names.size(); ++i) {
+            offset = align(offset);
+            entries[i].firstSerial = histories[i]->firstSerialNumber();
+            entries[i].length =
+                histories[i]->end() - histories[i]->begin();
+            entries[i].size = histories[i]->size();
+            entries[i].dataOffset = offset;
+            offset += entries[i].length*sizeof(Real);
+        }
+
+        std::ofstream out(fileName.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out, "unable to open " << fileName << " for writing");
+
+        out.write(magic, sizeof(magic));
+        writeValue(out, version);
+        writeValue(out, boost::uint32_t(sizeof(Real)));
+        writeValue(out, boost::uint64_t(names.size()));
+        writeValue(out, boost::uint64_t(0));
+        for (Size i=0; i<entries.size(); ++i) {
+            writeValue(out, entries[i].nameOffset);
+            writeValue(out, entries[i].nameLength);
+            writeValue(out, entries[i].firstSerial);
+            writeValue(out, entries[i].length);
+            writeValue(out, entries[i].size);
+            writeValue(out, entries[i].dataOffset);
+        }
+        for (Size i=0; i<names.size(); ++i)
+            out.write(names[i].data(), names[i].size());
+        const char padding[sizeof(Real)] = {};
+        for (Size i=0; i<names.size(); ++i) {
+            boost::uint64_t position = out.tellp();
+            out.write(padding, entries[i].dataOffset - position);
+            out.write(reinterpret_cast<const char*>(histories[i]->begin()),
+                      entries[i].length*sizeof(Real));
+        }
+        QL_REQUIRE(out, "error while writing " << fileName);
+    }
+
+    void saveFixingFile(const std::string& fileName) {
+        saveFixingFile(fileName, IndexManager::instance().histories());
+    }
+
+    void loadFixingFile(const std::string& fileName) {
+        using namespace boost::interprocess;
+
+        ext::shared_ptr<mapped_region> region;
+        try {
+            file_mapping file(fileName.c_str(), read_only);
+            region = ext::make_shared<mapped_region>(file, read_only);
+        } catch (interprocess_exception& e) {
+            QL_FAIL("unable to map " << fileName << ": " << e.what());
+        }
+        const char* base = static_cast<const char*>(region->get_address());
+        boost::uint64_t fileSize = region->get_size();
+
+        QL_REQUIRE(fileSize >= headerSize &&
+                   std::memcmp(base, magic, sizeof(magic)) == 0,
+                   fileName << " is not a fixing file");
+        QL_REQUIRE(readValue<boost::uint32_t>(base+8) == version,
+                   "unsupported version of fixing file " << fileName);
+        QL_REQUIRE(readValue<boost::uint32_t>(base+12) == sizeof(Real),
+                   fileName << " was written with a different Real type");
+        boost::uint64_t n = readValue<boost::uint64_t>(base+16);
+        QL_REQUIRE(n <= (fileSize - headerSize)/entrySize,
+                   "truncated fixing file " << fileName);
+
+        // validate the whole table before modifying any history
+        std::vector<Entry> entries(n);
+        for (Size i=0; i<n; ++i) {
+            const char* p = base + headerSize + i*entrySize;
+            Entry& e = entries[i];
+            e.nameOffset = readValue<boost::uint64_t>(p);
+            e.nameLength = readValue<boost::uint64_t>(p+8);
+            e.firstSerial = readValue<boost::int64_t>(p+16);
+            e.length = readValue<boost::uint64_t>(p+24);
+            e.size = readValue<boost::uint64_t>(p+32);
+            e.dataOffset = readValue<boost::uint64_t>(p+40);
+            QL_REQUIRE(e.nameOffset <= fileSize &&
+                       e.nameLength <= fileSize - e.nameOffset &&
+                       e.dataOffset <= fileSize &&
+                       e.length <= (fileSize - e.dataOffset)/sizeof(Real) &&
+                       e.dataOffset % sizeof(Real) == 0 &&
+                       e.size <= e.length,
+                       "corrupted entry #" << i+1
+                       << " in fixing file " << fileName);
+            boost::int64_t lastSerial =
+                e.firstSerial + boost::int64_t(e.length) - 1;
+            QL_REQUIRE(e.length == 0 ||
+                       (e.firstSerial >= Date::minDate().serialNumber() &&
+                        lastSerial <= Date::maxDate().serialNumber()),
+                       "invalid dates in entry #" << i+1
+                       << " in fixing file " << fileName);
+            // the history scans the array for its first and last fixings
+            if (e.size > 0) {
+                const Real* data =
+                    reinterpret_cast<const Real*>(base + e.dataOffset);
+                boost::uint64_t j = 0;
+                while (j < e.length && data[j] == Null<Real>())
+                    ++j;
+                QL_REQUIRE(j < e.length,
+                           "no fixings in non-empty entry #" << i+1
+                           << " in fixing file " << fileName);
+            }
+        }
+
+        IndexManager& manager = IndexManager::instance();
+        for (Size i=0; i<n; ++i) {
+            const Entry& e = entries[i];
+            std::string name(base + e.nameOffset, e.nameLength);
+            ext::shared_ptr<FixingHistory> history =
+                manager.registerHistory(name);
+            if (e.length == 0) {
+                history->clear();
+            } else {
+                const Real* data =
+                    reinterpret_cast<const Real*>(base + e.dataOffset);
+                history->attach(Date(Date::serial_type(e.firstSerial)),
+                                data, data + e.length, e.size, region);
+            }
+        }
+    }
+
+}
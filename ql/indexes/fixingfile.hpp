@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixingfile.hpp
+    \brief binary files of index fixings
+*/
+
+#ifndef quantlib_fixing_file_hpp
+#define quantlib_fixing_file_hpp
+
+#include <ql/types.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    /*! \defgroup fixingfiles Binary fixing files
+
+        A fixing file stores the histories of a set of indexes in the
+        same layout used in memory by FixingHistory, so that it can be
+        memory-mapped and used directly as their storage.  Loading a
+        file is then independent of the number of fixings, and
+        processes loading the same file share its pages.
+
+        The file contains, in native byte order:
+        - a 32-byte header made of the 8 characters "QLFIXING", the
+          format version and the size of Real as 32-bit integers,
+          and the number of histories as a 64-bit integer followed
+          by 8 bytes of padding;
+        - a table with an entry per history, made of six 64-bit
+          integers: offset and length of the index name, serial
+          number of the first date, length of the array of fixings,
+          number of non-null fixings, and offset of the array;
+        - the index names and the arrays of fixings, the latter
+          aligned to the size of Real.  Each array holds the fixings
+          for consecutive dates, with null values for dates without
+          a fixing.
+
+        Files are therefore not portable across platforms with a
+        different byte order.
+
+        @{
+    */
+
+    //! writes the fixings of the given indexes to a binary file
+    /*! Indexes without stored fixings are skipped. */
+    void saveFixingFile(const std::string& fileName,
+                        const std::vector<std::string>& indexNames);
+
+    //! writes all the fixings stored in the IndexManager to a binary file
+    void saveFixingFile(const std::string& fileName);
+
+    //! uses the fixings in a binary file as index histories
+    /*! The file is mapped in memory read-only and the histories of
+        the indexes it contains are replaced by views on the mapped
+        data; the mapping is released when none of them use it any
+        longer.  Fixings added later to one of these indexes cause
+        its history to be copied into memory owned by the process.
+
+        \warning the file must not be modified while it is in use.
+    */
+    void loadFixingFile(const std::string& fileName);
+
+    /*! @} */
+
+}
+
+
+#endif
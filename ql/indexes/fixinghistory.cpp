@@ -0,0 +1,178 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixinghistory.hpp>
+#if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+#include <mutex>
+#endif
+
+namespace QuantLib {
+
+    #if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+    namespace {
+        // constant-initialized, hence usable during static destruction
+        std::mutex registrationMutex;
+    }
+    #define QL_FIXING_HISTORY_LOCK \
+        std::lock_guard<std::mutex> lock(registrationMutex)
+    #else
+    #define QL_FIXING_HISTORY_LOCK
+    #endif
+
+    FixingHistory::FixingHistory()
+    : first_(0), data_(0), n_(0), size_(0), revision_(0),
+      seriesIsValid_(false) {}
+
+    Date FixingHistory::firstDate() const {
+        QL_REQUIRE(size_ > 0, "empty fixing history");
+        Size i = 0;
+        while (data_[i] == Null<Real>())
+            ++i;
+        return Date(first_ + Date::serial_type(i));
+    }
+
+    Date FixingHistory::lastDate() const {
+        QL_REQUIRE(size_ > 0, "empty fixing history");
+        Size i = n_-1;
+        while (data_[i] == Null<Real>())
+            --i;
+        return Date(first_ + Date::serial_type(i));
+    }
+
+    std::vector<Date> FixingHistory::dates() const {
+        std::vector<Date> result;
+        result.reserve(size_);
+        for (Size i=0; i<n_; ++i) {
+            if (data_[i] != Null<Real>())
+                result.push_back(Date(first_ + Date::serial_type(i)));
+        }
+        return result;
+    }
+
+    std::vector<Real> FixingHistory::values() const {
+        std::vector<Real> result;
+        result.reserve(size_);
+        for (Size i=0; i<n_; ++i) {
+            if (data_[i] != Null<Real>())
+                result.push_back(data_[i]);
+        }
+        return result;
+    }
+
+    const TimeSeries<Real>& FixingHistory::timeSeries() const {
+        if (!seriesIsValid_) {
+            std::vector<Date> d = dates();
+            std::vector<Real> v = values();
+            series_ = TimeSeries<Real>(d.begin(), d.end(), v.begin());
+            seriesIsValid_ = true;
+        }
+        return series_;
+    }
+
+    void FixingHistory::assign(const TimeSeries<Real>& fixings) {
+        std::vector<Date> d = fixings.dates();
+        std::vector<Real> v = fixings.values();
+        assign(d.begin(), d.end(), v.begin());
+    }
+
+    void FixingHistory::add(const Date& d, Real fixing) {
+        add(&d, &d+1, &fixing);
+    }
+
+    void FixingHistory::clear() {
+        reset();
+        ++revision_;
+        seriesIsValid_ = false;
+        notifyObservers();
+    }
+
+    void FixingHistory::registerObserver(
+                                const ext::shared_ptr<FixingHistory>& h,
+                                Observer* observer) {
+        QL_FIXING_HISTORY_LOCK;
+        observer->registerWith(h);
+    }
+
+    void FixingHistory::unregisterObserver(
+                                const ext::shared_ptr<FixingHistory>& h,
+                                Observer* observer) {
+        QL_FIXING_HISTORY_LOCK;
+        observer->unregisterWith(h);
+    }
+
+    void FixingHistory::attach(const Date& firstDate,
+                               const Real* begin, const Real* end,
+                               Size size,
+                               const ext::shared_ptr<void>& storage) {
+        QL_REQUIRE(end >= begin, "invalid fixing array");
+        QL_REQUIRE(size <= Size(end - begin),
+                   "number of fixings (" << size << ") larger than "
+                   "array size (" << end - begin << ")");
+        std::vector<Real>().swap(values_);
+        storage_ = storage;
+        first_ = firstDate.serialNumber();
+        data_ = begin;
+        n_ = end - begin;
+        size_ = size;
+        ++revision_;
+        seriesIsValid_ = false;
+        notifyObservers();
+    }
+
+    void FixingHistory::reset() {
+        std::vector<Real>().swap(values_);
+        storage_.reset();
+        first_ = 0;
+        data_ = 0;
+        n_ = 0;
+        size_ = 0;
+    }
+
+    void FixingHistory::extend(Date::serial_type first,
+                               Date::serial_type last) {
+        if (storage_) {
+            // copy external data before modifying them
+            values_.assign(data_, data_ + n_);
+            storage_.reset();
+        }
+        if (values_.empty()) {
+            first_ = first;
+            values_.resize(last - first + 1, Null<Real>());
+        } else {
+            if (first < first_) {
+                values_.insert(values_.begin(), first_ - first,
+                               Null<Real>());
+                first_ = first;
+            }
+            Date::serial_type n = last - first_ + 1;
+            if (n > Date::serial_type(values_.size()))
+                values_.resize(n, Null<Real>());
+        }
+        data_ = &values_[0];
+        n_ = values_.size();
+    }
+
+    void FixingHistory::store(Date::serial_type serial, Real fixing) {
+        Real& x = values_[serial - first_];
+        if (x == Null<Real>() && fixing != Null<Real>())
+            ++size_;
+        else if (x != Null<Real>() && fixing == Null<Real>())
+            --size_;
+        x = fixing;
+    }
+
+}
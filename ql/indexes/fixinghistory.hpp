@@ -0,0 +1,226 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixinghistory.hpp
+    \brief dense storage for the past fixings of an index
+*/
+
+#ifndef quantlib_fixing_history_hpp
+#define quantlib_fixing_history_hpp
+
+#include <ql/timeseries.hpp>
+#include <ql/patterns/observable.hpp>
+
+namespace QuantLib {
+
+    //! dense storage for the past fixings of an index
+    /*! Fixings are stored in a contiguous array indexed by the
+        serial number of the fixing date, so that retrieving the
+        fixing at a given date does not require any search.  Dates
+        in the covered range for which no fixing was stored hold a
+        null value.
+
+        The array can be owned by the history or, as in the case of
+        fixings loaded from a file by loadFixingFile(), live in
+        external read-only storage; in the latter case, it is copied
+        the first time the fixings are modified.
+
+        Observers are notified whenever the stored fixings change.
+        Histories are shared by all the indexes with the same name,
+        possibly created in different threads; therefore, indexes
+        register with them by means of registerObserver(), which is
+        synchronized when thread-local settings are enabled.
+
+        \note null values are not stored; adding a null fixing
+              removes the one possibly stored at the same date.
+    */
+    class FixingHistory : public Observable {
+      public:
+        FixingHistory();
+        //! \name Inspectors
+        //@{
+        //! returns the (possibly null) fixing at the given date
+        Real operator[](const Date& d) const;
+        //! returns whether a fixing was stored at the given date
+        bool hasFixing(const Date& d) const;
+        //! returns the number of stored fixings
+        Size size() const;
+        //! returns whether any fixing was stored
+        bool empty() const;
+        //! returns the first date for which a fixing was stored
+        Date firstDate() const;
+        //! returns the last date for which a fixing was stored
+        Date lastDate() const;
+        //! returns the dates for which a fixing was stored
+        std::vector<Date> dates() const;
+        //! returns the stored fixings
+        std::vector<Real> values() const;
+        //! returns a counter increased whenever the fixings change
+        /*! This allows clients to cache results depending on the
+            fixings and to check whether they are still valid.
+        */
+        unsigned long revision() const;
+        //! returns the stored fixings as a time series
+        /*! The series is built on first access and cached until the
+            stored fixings change.
+        */
+        const TimeSeries<Real>& timeSeries() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        //! replaces the stored fixings with the given ones
+        void assign(const TimeSeries<Real>& fixings);
+        //! replaces the stored fixings with the given ones
+        template <class DateIterator, class ValueIterator>
+        void assign(DateIterator dBegin, DateIterator dEnd,
+                    ValueIterator vBegin);
+        //! stores a fixing, overwriting the existing one if any
+        void add(const Date& d, Real fixing);
+        //! stores a set of fixings, overwriting the existing ones if any
+        /*! The range of covered dates is extended at most once, so
+            that loading a large history is linear in its size.
+            Observers are notified once at the end.
+
+            \pre the iterators must allow multiple passes.
+        */
+        template <class DateIterator, class ValueIterator>
+        void add(DateIterator dBegin, DateIterator dEnd,
+                 ValueIterator vBegin);
+        //! removes all stored fixings
+        void clear();
+        //! uses the given external array as storage for the fixings
+        /*! The array holds the fixings for consecutive dates
+            starting from <b><i>firstDate</i></b>, with null values
+            for dates without a fixing; <b><i>size</i></b> is the
+            number of non-null values.  The storage is kept alive
+            as long as the history uses it.
+        */
+        void attach(const Date& firstDate,
+                    const Real* begin, const Real* end, Size size,
+                    const ext::shared_ptr<void>& storage);
+        //@}
+        //! \name Raw data access
+        //@{
+        //! returns the serial number of the first date in the array
+        Date::serial_type firstSerialNumber() const;
+        //! returns the array of fixings, including null values
+        const Real* begin() const;
+        const Real* end() const;
+        //@}
+        //! \name Observer registration
+        //@{
+        //! registers the observer with the given history
+        /*! When thread-local settings are enabled, calls to this
+            method and to unregisterObserver() are serialized, so
+            that observers of the same history can be created and
+            destroyed in different threads.
+
+            \warning notifications are not synchronized; the fixings
+                     shouldn't be modified while other threads might
+                     register or unregister observers.
+        */
+        static void registerObserver(
+                                const ext::shared_ptr<FixingHistory>& h,
+                                Observer* observer);
+        //! unregisters the observer from the given history
+        static void unregisterObserver(
+                                const ext::shared_ptr<FixingHistory>& h,
+                                Observer* observer);
+        //@}
+      private:
+        void extend(Date::serial_type first, Date::serial_type last);
+        void store(Date::serial_type serial, Real fixing);
+        void reset();
+        Date::serial_type first_;
+        const Real* data_;
+        Size n_;
+        std::vector<Real> values_;
+        ext::shared_ptr<void> storage_;
+        Size size_;
+        unsigned long revision_;
+        mutable TimeSeries<Real> series_;
+        mutable bool seriesIsValid_;
+    };
+
+
+    // inline definitions
+
+    inline Real FixingHistory::operator[](const Date& d) const {
+        Date::serial_type i = d.serialNumber() - first_;
+        if (i < 0 || i >= Date::serial_type(n_))
+            return Null<Real>();
+        return data_[i];
+    }
+
+    inline bool FixingHistory::hasFixing(const Date& d) const {
+        return (*this)[d] != Null<Real>();
+    }
+
+    inline Size FixingHistory::size() const {
+        return size_;
+    }
+
+    inline bool FixingHistory::empty() const {
+        return size_ == 0;
+    }
+
+    inline unsigned long FixingHistory::revision() const {
+        return revision_;
+    }
+
+    inline Date::serial_type FixingHistory::firstSerialNumber() const {
+        return first_;
+    }
+
+    inline const Real* FixingHistory::begin() const {
+        return data_;
+    }
+
+    inline const Real* FixingHistory::end() const {
+        return data_ + n_;
+    }
+
+    template <class DateIterator, class ValueIterator>
+    void FixingHistory::assign(DateIterator dBegin, DateIterator dEnd,
+                               ValueIterator vBegin) {
+        reset();
+        add(dBegin, dEnd, vBegin);
+    }
+
+    template <class DateIterator, class ValueIterator>
+    void FixingHistory::add(DateIterator dBegin, DateIterator dEnd,
+                            ValueIterator vBegin) {
+        if (dBegin != dEnd) {
+            Date::serial_type first = dBegin->serialNumber(),
+                              last = first;
+            for (DateIterator d = dBegin; d != dEnd; ++d) {
+                first = std::min<Date::serial_type>(first, d->serialNumber());
+                last = std::max<Date::serial_type>(last, d->serialNumber());
+            }
+            extend(first, last);
+            for (; dBegin != dEnd; ++dBegin, ++vBegin)
+                store(dBegin->serialNumber(), *vBegin);
+        }
+        ++revision_;
+        seriesIsValid_ = false;
+        notifyObservers();
+    }
+
+}
+
+
+#endif
@@ -74,8 +74,8 @@ namespace QuantLib {
            can ask a 6-months index for a 1-year fixing.
 
            For that reason, we're leaving this method private and
-           we're declaring the IborCoupon class (which uses it) as a
-           friend.  Should the need arise, we might promote it to
+           we're declaring the IborCoupon and CompactLeg classes
+           (which use it) as friends.  Should the need arise, we might promote it to
            public, but before doing that I'd think hard whether we
            have any other way to get the same results.
         */
@@ -83,6 +83,7 @@ namespace QuantLib {
                             const Date& endDate,
                             Time t) const;
         friend class IborCoupon;
+        friend class CompactLeg;
     };
 
 
@@ -30,42 +30,84 @@
 using boost::algorithm::to_upper_copy;
 using std::string;
 
+#if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+#define QL_INDEX_MANAGER_LOCK std::lock_guard<std::mutex> lock(mutex_)
+#else
+#define QL_INDEX_MANAGER_LOCK
+#endif
+
 namespace QuantLib {
 
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        QL_INDEX_MANAGER_LOCK;
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        return i != data_.end() && !i->second->empty();
+    }
+
+    ext::shared_ptr<FixingHistory>
+    IndexManager::fixingHistory(const string& name) const {
+        QL_INDEX_MANAGER_LOCK;
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        if (i == data_.end())
+            return ext::shared_ptr<FixingHistory>();
+        return i->second;
+    }
+
+    ext::shared_ptr<FixingHistory>
+    IndexManager::registerHistory(const string& name) {
+        QL_INDEX_MANAGER_LOCK;
+        ext::shared_ptr<FixingHistory>& h = data_[to_upper_copy(name)];
+        if (!h)
+            h = ext::make_shared<FixingHistory>();
+        return h;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        static const TimeSeries<Real> empty;
+        ext::shared_ptr<FixingHistory> h = fixingHistory(name);
+        return h ? h->timeSeries() : empty;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        registerHistory(name)->assign(history);
     }
 
     ext::shared_ptr<Observable>
-    IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+    IndexManager::notifier(const string& name) {
+        return registerHistory(name);
     }
 
     std::vector<string> IndexManager::histories() const {
+        QL_INDEX_MANAGER_LOCK;
         std::vector<string> temp;
         temp.reserve(data_.size());
         for (history_map::const_iterator i=data_.begin();
              i!=data_.end(); ++i)
-            temp.push_back(i->first);
+            if (!i->second->empty())
+                temp.push_back(i->first);
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        // observers are notified outside the lock
+        ext::shared_ptr<FixingHistory> h = fixingHistory(name);
+        if (h)
+            h->clear();
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        std::vector<ext::shared_ptr<FixingHistory> > histories;
+        {
+            QL_INDEX_MANAGER_LOCK;
+            histories.reserve(data_.size());
+            for (history_map::const_iterator i=data_.begin();
+                 i!=data_.end(); ++i)
+                histories.push_back(i->second);
+        }
+        for (Size i=0; i<histories.size(); ++i)
+            histories[i]->clear();
     }
 
 }
@@ -24,15 +24,29 @@
 #ifndef quantlib_index_manager_hpp
 #define quantlib_index_manager_hpp
 
-#include <ql/timeseries.hpp>
+#include <ql/indexes/fixinghistory.hpp>
 #include <ql/patterns/singleton.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+#include <mutex>
+#endif
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Fixings are kept in a FixingHistory instance per index.  Such
+        instances are never removed from the repository, so that
+        indexes can look them up once and keep them; clearing the
+        fixings of an index empties its history instead.
+
+        When thread-local settings are enabled, access to the
+        repository is synchronized, so that histories can be looked
+        up and registered by several threads; the histories
+        themselves are not, except for the registration of their
+        observers (see FixingHistory::registerObserver).
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
@@ -40,12 +54,25 @@ namespace QuantLib {
       public:
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
+        //! returns the fixing history of the index
+        /*! A null pointer is returned if no history was registered
+            for the index.
+        */
+        ext::shared_ptr<FixingHistory>
+        fixingHistory(const std::string& name) const;
+        //! returns the fixing history of the index, creating it if needed
+        /*! The history is created empty if no history was registered
+            for the index; it is returned unchanged otherwise.
+        */
+        ext::shared_ptr<FixingHistory>
+        registerHistory(const std::string& name);
         //! returns the (possibly empty) history of the index fixings
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
         //! observer notifying of changes in the index fixings
-        ext::shared_ptr<Observable> notifier(const std::string& name) const;
+        /*! The fixing history of the index is registered if needed. */
+        ext::shared_ptr<Observable> notifier(const std::string& name);
         //! returns all names of the indexes for which fixings were stored
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
@@ -53,9 +80,12 @@ namespace QuantLib {
         //! clears all stored fixings
         void clearHistories();
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
+        typedef std::map<std::string, ext::shared_ptr<FixingHistory> >
                                                                   history_map;
-        mutable history_map data_;
+        history_map data_;
+        #if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+        mutable std::mutex mutex_;
+        #endif
     };
 
 }
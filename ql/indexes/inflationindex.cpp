@@ -36,7 +36,12 @@ namespace QuantLib {
       currency_(currency) {
         name_ = region_.name() + " " + familyName_;
         registerWith(Settings::instance().evaluationDate());
-        registerWith(IndexManager::instance().notifier(name()));
+        FixingHistory::registerObserver(fixingHistory(), this);
+    }
+
+    InflationIndex::~InflationIndex() {
+        // the history is shared with indexes in other threads
+        FixingHistory::unregisterObserver(fixingHistory(), this);
     }
 
 
@@ -81,7 +86,7 @@ namespace QuantLib {
                                     bool /*forecastTodaysFixing*/) const {
         if (!needsForecast(aFixingDate)) {
             std::pair<Date,Date> lim = inflationPeriod(aFixingDate, frequency_);
-            const TimeSeries<Real>& ts = timeSeries();
+            const FixingHistory& ts = *fixingHistory();
             Real pastFixing = ts[lim.first];
             QL_REQUIRE(pastFixing != Null<Real>(),
                        "Missing " << name() << " fixing for " << lim.first);
@@ -145,7 +150,7 @@ namespace QuantLib {
             // we're not sure, but the fixing might be there so we
             // check.  Todo: check which fixings are not possible, to
             // avoid using fixings in the future
-            Real f = timeSeries()[latestNeededDate];
+            Real f = (*fixingHistory())[latestNeededDate];
             return (f == Null<Real>());
         }
     }
@@ -228,7 +233,7 @@ namespace QuantLib {
 
         // four cases with ratio() and interpolated()
 
-        const TimeSeries<Real>& ts = timeSeries();
+        const FixingHistory& ts = *fixingHistory();
         if (ratio()) {
 
             if(interpolated()){ // IS ratio, IS interpolated
@@ -255,8 +260,7 @@ namespace QuantLib {
                 QL_REQUIRE(limBefFirstFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.first );
-                Rate limBefSecondFix =
-                IndexManager::instance().getHistory(name())[limBef.second+1];
+                Rate limBefSecondFix = ts[limBef.second+1];
                 QL_REQUIRE(limBefSecondFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.second+1 );
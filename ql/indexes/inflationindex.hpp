@@ -55,6 +55,7 @@ namespace QuantLib {
                        Frequency frequency,
                        const Period& availabilitiyLag,
                        const Currency& currency);
+        ~InflationIndex();
         //! \name Index interface
         //@{
         std::string name() const;
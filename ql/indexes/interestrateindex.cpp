@@ -55,7 +55,12 @@ namespace QuantLib {
         name_ = out.str();
 
         registerWith(Settings::instance().evaluationDate());
-        registerWith(IndexManager::instance().notifier(name()));
+        FixingHistory::registerObserver(fixingHistory(), this);
+    }
+
+    InterestRateIndex::~InterestRateIndex() {
+        // the history is shared with indexes in other threads
+        FixingHistory::unregisterObserver(fixingHistory(), this);
     }
 
     Rate InterestRateIndex::fixing(const Date& fixingDate,
@@ -45,6 +45,7 @@ namespace QuantLib {
                           const Currency& currency,
                           const Calendar& fixingCalendar,
                           const DayCounter& dayCounter);
+        ~InterestRateIndex();
         //! \name Index interface
         //@{
         std::string name() const;
@@ -127,7 +128,7 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return (*fixingHistory())[fixingDate];
     }
 
 }
@@ -42,12 +42,39 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // storage aligned on 64-byte boundaries; the offset from the
+        // allocated block is kept in the byte preceding the returned one
+        inline Real* allocate_aligned_reals(Size n) {
+            const std::size_t alignment = 64;
+            char* block = new char[n*sizeof(Real) + alignment];
+            std::size_t offset =
+                alignment - reinterpret_cast<std::size_t>(block) % alignment;
+            char* aligned = block + offset;
+            aligned[-1] = static_cast<char>(offset);
+            return reinterpret_cast<Real*>(aligned);
+        }
+
+        inline void deallocate_aligned_reals(Real* p) {
+            char* aligned = reinterpret_cast<char*>(p);
+            delete[] (aligned - static_cast<unsigned char>(aligned[-1]));
+        }
+
+    }
+
     //! 1-D array used in linear algebra.
     /*! This class implements the concept of vector as used in linear
         algebra.
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
+        Arrays of up to four elements, such as the ones returned by the
+        drift and diffusion of most multi-dimensional processes, are
+        stored inline without any heap allocation; larger ones are
+        allocated on 64-byte boundaries so that loops over them can be
+        vectorized.
+
         \test construction of arrays is checked in a number of cases
     */
     class Array {
@@ -67,6 +94,7 @@ namespace QuantLib {
         //! creates the array from an iterable sequence
         template <class ForwardIterator>
         Array(ForwardIterator begin, ForwardIterator end);
+        ~Array();
 
         Array& operator=(const Array&);
         Array& operator=(const Disposable<Array>&);
@@ -138,8 +166,12 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        enum { InlineSize = 4 };
+        void allocate(Size n);
+        void deallocate();
+        Real* data_;
         Size n_;
+        Real buffer_[InlineSize];
     };
 
     //! specialization of null template for this class
@@ -202,6 +234,71 @@ namespace QuantLib {
     /*! \relates Array */
     const Disposable<Array> Pow(const Array&, Real);
 
+
+    // overloads reusing the storage of temporaries
+
+    /* When an operand is a temporary returned by another operation, its
+       storage is reused for the result; chained expressions such as
+       a*x + b*y - z then allocate only for the innermost terms.
+       If both operands are the same object, as in d + d, its storage
+       can't be reused while it's still being read, and the result is
+       computed as for two Array instances.  As when copying it, a
+       Disposable passed as an operand is left empty; keep results to
+       be used more than once in an Array.
+    */
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>& v);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator+(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator-(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator*(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator/(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Abs(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Sqrt(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Log(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Exp(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Pow(const Disposable<Array>&, Real);
+
     // utilities
     /*! \relates Array */
     void swap(Array&, Array&);
@@ -213,39 +310,57 @@ namespace QuantLib {
 
     // inline definitions
 
+    inline void Array::allocate(Size n) {
+        // only called on empty arrays with inline storage
+        if (n > Size(InlineSize))
+            data_ = detail::allocate_aligned_reals(n);
+        n_ = n;
+    }
+
+    inline void Array::deallocate() {
+        if (data_ != buffer_)
+            detail::deallocate_aligned_reals(data_);
+        data_ = buffer_;
+        n_ = 0;
+    }
+
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : data_(buffer_), n_(0) {
+        allocate(size);
+    }
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(buffer_), n_(0) {
+        allocate(size);
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(buffer_), n_(0) {
+        allocate(size);
         for (iterator i=begin(); i!=end(); ++i, value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (n_)
-        #endif
+    : data_(buffer_), n_(0) {
+        allocate(from.n_);
         std::copy(from.begin(),from.end(),begin());
     }
 
     inline Array::Array(const Disposable<Array>& from)
-    : data_((Real*)(0)), n_(0) {
+    : data_(buffer_), n_(0) {
         swap(const_cast<Disposable<Array>&>(from));
     }
 
+    inline Array::~Array() {
+        deallocate();
+    }
+
     namespace detail {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::true_type&) {
             // we got redirected here from a call like Array(3, 4)
@@ -254,34 +369,28 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
+            a.resize(n);
             std::fill(a.begin(),a.end(),value);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
-            #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-            if (n_)
-            #endif
+            a.resize(n);
             std::copy(begin, end, a.begin());
         }
 
     }
 
     template <class ForwardIterator>
-    inline Array::Array(ForwardIterator begin, ForwardIterator end) {
+    inline Array::Array(ForwardIterator begin, ForwardIterator end)
+    : data_(buffer_), n_(0) {
         // Unfortunately, calls such as Array(3, 4) match this constructor.
         // We have to detect integral types and dispatch.
-        detail::_fill_array_(*this, data_, n_, begin, end,
+        detail::_fill_array_(*this, begin, end,
                              boost::is_integral<ForwardIterator>());
     }
 
@@ -372,28 +481,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::at(Size i) const {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::front() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real Array::back() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Real& Array::operator[](Size i) {
@@ -402,28 +511,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::at(Size i) {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::front() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real& Array::back() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Size Array::size() const {
@@ -435,19 +544,19 @@ namespace QuantLib {
     }
 
     inline Array::const_iterator Array::begin() const {
-        return data_.get();
+        return data_;
     }
 
     inline Array::iterator Array::begin() {
-        return data_.get();
+        return data_;
     }
 
     inline Array::const_iterator Array::end() const {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::iterator Array::end() {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::const_reverse_iterator Array::rbegin() const {
@@ -467,7 +576,9 @@ namespace QuantLib {
     }
 
     inline void Array::resize(Size n) {
-        if (n > n_) {
+        if (n > n_ && data_ == buffer_ && n <= Size(InlineSize)) {
+            n_ = n;
+        } else if (n > n_) {
             Array swp(n);
             std::copy(begin(), end(), swp.begin());
             swap(swp);
@@ -479,7 +590,28 @@ namespace QuantLib {
 
     inline void Array::swap(Array& from) {
         using std::swap;
-        data_.swap(from.data_);
+        if (data_ != buffer_ && from.data_ != from.buffer_) {
+            swap(data_,from.data_);
+        } else {
+            // at least one of the two arrays is stored inline
+            Real* data = data_;
+            Real* fromData = from.data_;
+            Real temp[InlineSize];
+            if (data == buffer_)
+                std::copy(buffer_, buffer_+n_, temp);
+            if (fromData == from.buffer_) {
+                std::copy(from.buffer_, from.buffer_+from.n_, buffer_);
+                data_ = buffer_;
+            } else {
+                data_ = fromData;
+            }
+            if (data == buffer_) {
+                std::copy(temp, temp+n_, from.buffer_);
+                from.data_ = from.buffer_;
+            } else {
+                from.data_ = data;
+            }
+        }
         swap(n_,from.n_);
     }
 
@@ -652,6 +784,239 @@ namespace QuantLib {
         return result;
     }
 
+    // overloads reusing the storage of temporaries
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v) {
+        Array result(v);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::negate<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) +
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result += v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) +
+                   static_cast<const Array&>(v2);
+        Array result(v2);
+        result += v1;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) +
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result += v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result(v1);
+        result += a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result(v2);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       add<Real>(a));
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) -
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result -= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) -
+                   static_cast<const Array&>(v2);
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be subtracted");
+        Array result(v2);
+        std::transform(v1.begin(),v1.end(),result.begin(),result.begin(),
+                       std::minus<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) -
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result -= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result(v1);
+        result -= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result(v2);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       subtract_from<Real>(a));
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) *
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result *= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) *
+                   static_cast<const Array&>(v2);
+        Array result(v2);
+        result *= v1;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) *
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result *= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result(v1);
+        result *= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result(v2);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       multiply_by<Real>(a));
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) /
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result /= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) /
+                   static_cast<const Array&>(v2);
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be divided");
+        Array result(v2);
+        std::transform(v1.begin(),v1.end(),result.begin(),result.begin(),
+                       std::divides<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        if (&v1 == &v2)
+            return static_cast<const Array&>(v1) /
+                   static_cast<const Array&>(v2);
+        Array result(v1);
+        result /= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result(v1);
+        result /= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result(v2);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       divide<Real>(a));
+        return result;
+    }
+
+    inline const Disposable<Array> Abs(const Disposable<Array>& v) {
+        Array result(v);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       static_cast<Real(*)(Real)>(std::fabs));
+        return result;
+    }
+
+    inline const Disposable<Array> Sqrt(const Disposable<Array>& v) {
+        Array result(v);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       static_cast<Real(*)(Real)>(std::sqrt));
+        return result;
+    }
+
+    inline const Disposable<Array> Log(const Disposable<Array>& v) {
+        Array result(v);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       static_cast<Real(*)(Real)>(std::log));
+        return result;
+    }
+
+    inline const Disposable<Array> Exp(const Disposable<Array>& v) {
+        Array result(v);
+        std::transform(result.begin(),result.end(),result.begin(),
+                       static_cast<Real(*)(Real)>(std::exp));
+        return result;
+    }
+
+    inline const Disposable<Array> Pow(const Disposable<Array>& v,
+                                       Real alpha) {
+        Array result(v);
+        for (Size i=0; i<result.size(); ++i)
+            result[i] = std::pow(result[i], alpha);
+        return result;
+    }
+
 
     inline void swap(Array& v, Array& w) {
         v.swap(w);
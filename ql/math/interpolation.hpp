@@ -65,6 +65,10 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            virtual void values(const Real* x, Real* y, Size n) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -118,6 +122,23 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! same as locate(x), but starting the search from the
+                result for a previous abscissa; when abscissas are
+                located in increasing order, the interval is usually
+                found in a few steps.
+            */
+            Size locate(Real x, Size previous) const {
+                if (x < xBegin_[previous])
+                    return locate(x);
+                const Size last = (xEnd_-xBegin_)-2;
+                Size i = previous;
+                for (Size k=0; k<4; ++k) {
+                    if (i >= last || x < xBegin_[i+1])
+                        return i;
+                    ++i;
+                }
+                return std::upper_bound(xBegin_+i,xEnd_-1,x)-xBegin_-1;
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -129,6 +150,26 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! evaluates the interpolation at the <b><i>n</i></b> points
+            in <b><i>x</i></b> and writes the results in
+            <b><i>y</i></b>.  Most interpolations locate each point
+            starting from the interval of the previous one; therefore,
+            this is faster than repeated calls to the single-point
+            version, especially when the points are sorted.
+        */
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            if (n == 0)
+                return;
+            Real xMin = x[0], xMax = x[0];
+            for (Size i=1; i<n; ++i) {
+                xMin = std::min(xMin, x[i]);
+                xMax = std::max(xMax, x[i]);
+            }
+            checkRange(xMin,allowExtrapolation);
+            checkRange(xMax,allowExtrapolation);
+            impl_->values(x, y, n);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -94,6 +94,22 @@ namespace QuantLib {
                 else
                     return this->yBegin_[i+1];
             }
+            void values(const Real* x, Real* y, Size n) const {
+                if (std::distance(this->xBegin_, this->xEnd_) == 1) {
+                    std::fill(y, y+n, this->yBegin_[0]);
+                    return;
+                }
+                Size i = 0;
+                for (Size k=0; k<n; ++k) {
+                    if (x[k] <= this->xBegin_[0]) {
+                        y[k] = this->yBegin_[0];
+                    } else {
+                        i = this->locate(x[k], i);
+                        y[k] = (x[k] == this->xBegin_[i]) ?
+                            this->yBegin_[i] : this->yBegin_[i+1];
+                    }
+                }
+            }
             Real primitive(Real x) const {
                 if (std::distance(this->xBegin_, this->xEnd_) == 1)
                     return (x - this->xBegin_[0]) * this->yBegin_[0];
@@ -212,6 +212,7 @@ namespace QuantLib {
             void update();
 
             Real value(Real x) const;
+            void values(const Real* x, Real* y, Size n) const;
             Real primitive(Real x) const;
             Real derivative(Real) const {
                 QL_FAIL("Convex-monotone spline derivative not implemented");
@@ -854,6 +855,26 @@ namespace QuantLib {
             return sectionHelpers_.upper_bound(x)->second->value(x);
         }
 
+        template <class I1, class I2>
+        void ConvexMonotoneImpl<I1,I2>::values(const Real* x, Real* y,
+                                               Size n) const {
+            typename helper_map::const_iterator section =
+                sectionHelpers_.end();
+            for (Size k=0; k<n; ++k) {
+                if (x[k] >= *(this->xEnd_-1)) {
+                    y[k] = extrapolationHelper_->value(x[k]);
+                    continue;
+                }
+                // walk forward from the previous section if possible
+                if (section == sectionHelpers_.end() || x[k] < x[k-1])
+                    section = sectionHelpers_.upper_bound(x[k]);
+                else
+                    while (section->first <= x[k])
+                        ++section;
+                y[k] = section->second->value(x[k]);
+            }
+        }
+
         template <class I1, class I2>
         Real ConvexMonotoneImpl<I1,I2>::primitive(Real x) const {
             if (x >= *(this->xEnd_-1)) {
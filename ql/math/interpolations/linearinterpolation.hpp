@@ -89,6 +89,13 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
             }
+            void values(const Real* x, Real* y, Size n) const {
+                Size i = 0;
+                for (Size k=0; k<n; ++k) {
+                    i = this->locate(x[k], i);
+                    y[k] = this->yBegin_[i] + (x[k]-this->xBegin_[i])*s_[i];
+                }
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -324,6 +324,11 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            void values(const Real* x, Real* y, Size n) const {
+                interpolation_(x, y, n, true);
+                for (Size k=0; k<n; ++k)
+                    y[k] = std::exp(y[k]);
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
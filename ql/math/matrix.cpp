@@ -22,6 +22,7 @@
 */
 
 #include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #if defined(QL_PATCH_MSVC)
 #pragma warning(push)
 #pragma warning(disable:4180)
@@ -62,6 +63,101 @@
 
 namespace QuantLib {
 
+    const Disposable<Array> operator*(const Array& v, const Matrix& m) {
+        QL_REQUIRE(v.size() == m.rows(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.columns());
+        #if defined(QL_USE_LAPACK)
+        if (!m.empty()) {
+            // the column-major view of m is its transpose
+            const int rows = int(m.columns()), columns = int(m.rows());
+            const int one = 1;
+            const double alpha = 1.0, beta = 0.0;
+            dgemv_("N", &rows, &columns, &alpha, m.begin(), &rows,
+                   v.begin(), &one, &beta, result.begin(), &one);
+            return result;
+        }
+        #endif
+        for (Size i=0; i<result.size(); i++)
+            result[i] =
+                std::inner_product(v.begin(),v.end(),
+                                   m.column_begin(i),0.0);
+        return result;
+    }
+
+    const Disposable<Array> operator*(const Matrix& m, const Array& v) {
+        QL_REQUIRE(v.size() == m.columns(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.rows());
+        #if defined(QL_USE_LAPACK)
+        if (!m.empty()) {
+            const int rows = int(m.columns()), columns = int(m.rows());
+            const int one = 1;
+            const double alpha = 1.0, beta = 0.0;
+            dgemv_("T", &rows, &columns, &alpha, m.begin(), &rows,
+                   v.begin(), &one, &beta, result.begin(), &one);
+            return result;
+        }
+        #endif
+        for (Size i=0; i<result.size(); i++)
+            result[i] =
+                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
+        return result;
+    }
+
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        Matrix result(m1.rows(),m2.columns(),0.0);
+        if (result.empty() || m1.columns() == 0)
+            return result;
+
+        #if defined(QL_USE_LAPACK)
+
+        // in column-major terms, we calculate m2^T m1^T = (m1 m2)^T
+        const int rows = int(m2.columns()), columns = int(m1.rows()),
+                  inner = int(m1.columns());
+        const double alpha = 1.0, beta = 0.0;
+        dgemm_("N", "N", &rows, &columns, &inner, &alpha,
+               m2.begin(), &rows, m1.begin(), &inner,
+               &beta, result.begin(), &rows);
+
+        #else
+
+        // Blocks of m2 are kept in cache while they are applied to all
+        // the rows of m1; for each element of the result, the terms are
+        // still added in the natural order.
+        const Size blockSize = 64;
+        const Size inner = m1.columns(), columns = m2.columns();
+        for (Size kk=0; kk<inner; kk+=blockSize) {
+            const Size kEnd = std::min(kk+blockSize, inner);
+            for (Size jj=0; jj<columns; jj+=blockSize) {
+                const Size jEnd = std::min(jj+blockSize, columns);
+                for (Size i=0; i<result.rows(); ++i) {
+                    Matrix::const_row_iterator a = m1.row_begin(i);
+                    Matrix::row_iterator c = result.row_begin(i);
+                    for (Size k=kk; k<kEnd; ++k) {
+                        const Real aik = a[k];
+                        Matrix::const_row_iterator b = m2.row_begin(k);
+                        for (Size j=jj; j<jEnd; ++j)
+                            c[j] += aik*b[j];
+                    }
+                }
+            }
+        }
+
+        #endif
+
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
@@ -155,6 +155,31 @@ namespace QuantLib {
     const Disposable<Matrix> operator/(const Matrix&, Real);
 
 
+    // overloads reusing the storage of temporaries
+
+    /* As for Array, the storage of a temporary operand is reused for
+       the result unless both operands are the same object.
+    */
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(const Disposable<Matrix>&, const Matrix&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(const Matrix&, const Disposable<Matrix>&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(const Disposable<Matrix>&, const Disposable<Matrix>&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(const Disposable<Matrix>&, const Matrix&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(const Matrix&, const Disposable<Matrix>&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(const Disposable<Matrix>&, const Disposable<Matrix>&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator*(const Disposable<Matrix>&, Real);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator*(Real, const Disposable<Matrix>&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator/(const Disposable<Matrix>&, Real);
+
+
     // vectorial products
 
     /*! \relates Matrix */
@@ -525,47 +550,94 @@ namespace QuantLib {
         return temp;
     }
 
-    inline const Disposable<Array> operator*(const Array& v, const Matrix& m) {
-        QL_REQUIRE(v.size() == m.rows(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
-        return result;
+    // overloads reusing the storage of temporaries
+
+    inline const Disposable<Matrix> operator+(const Disposable<Matrix>& m1,
+                                              const Matrix& m2) {
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) +
+                   static_cast<const Matrix&>(m2);
+        Matrix temp(m1);
+        temp += m2;
+        return temp;
     }
 
-    inline const Disposable<Array> operator*(const Matrix& m, const Array& v) {
-        QL_REQUIRE(v.size() == m.columns(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.rows());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
-        return result;
+    inline const Disposable<Matrix> operator+(const Matrix& m1,
+                                              const Disposable<Matrix>& m2) {
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) +
+                   static_cast<const Matrix&>(m2);
+        Matrix temp(m2);
+        temp += m1;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator+(const Disposable<Matrix>& m1,
+                                              const Disposable<Matrix>& m2) {
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) +
+                   static_cast<const Matrix&>(m2);
+        Matrix temp(m1);
+        temp += m2;
+        return temp;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
+    inline const Disposable<Matrix> operator-(const Disposable<Matrix>& m1,
                                               const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) -
+                   static_cast<const Matrix&>(m2);
+        Matrix temp(m1);
+        temp -= m2;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator-(const Matrix& m1,
+                                              const Disposable<Matrix>& m2) {
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) -
+                   static_cast<const Matrix&>(m2);
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+                   m1.columns() == m2.columns(),
                    "matrices with different sizes (" <<
                    m1.rows() << "x" << m1.columns() << ", " <<
                    m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
-                }
-            }
-        }
-        return result;
+                   "subtracted");
+        Matrix temp(m2);
+        std::transform(m1.begin(),m1.end(),temp.begin(),temp.begin(),
+                       std::minus<Real>());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator-(const Disposable<Matrix>& m1,
+                                              const Disposable<Matrix>& m2) {
+        if (&m1 == &m2)
+            return static_cast<const Matrix&>(m1) -
+                   static_cast<const Matrix&>(m2);
+        Matrix temp(m1);
+        temp -= m2;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator*(const Disposable<Matrix>& m,
+                                              Real x) {
+        Matrix temp(m);
+        temp *= x;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator*(Real x,
+                                              const Disposable<Matrix>& m) {
+        Matrix temp(m);
+        temp *= x;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator/(const Disposable<Matrix>& m,
+                                              Real x) {
+        Matrix temp(m);
+        temp /= x;
+        return temp;
     }
 
     inline const Disposable<Matrix> transpose(const Matrix& m) {
@@ -20,6 +20,7 @@
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 
 namespace QuantLib {
 
@@ -36,6 +37,25 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_USE_LAPACK)
+        if (size > 0) {
+            // S is symmetric, so its column-major view is S itself and
+            // the upper factor U = L^T in column-major order reads as L.
+            Matrix result = S;
+            const int n = int(size);
+            int info = 0;
+            dpotrf_("U", &n, result.begin(), &n, &info);
+            if (info == 0) {
+                for (i=0; i<size; i++)
+                    for (j=i+1; j<size; j++)
+                        result[i][j] = 0.0;
+                return result;
+            }
+            QL_REQUIRE(flexible, "input matrix is not positive definite");
+            // positive semi-definite matrices are handled below
+        }
+        #endif
+
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
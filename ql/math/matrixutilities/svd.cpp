@@ -34,9 +34,13 @@
 
 
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
+#include <vector>
 
 namespace QuantLib {
 
+    #if !defined(QL_USE_LAPACK)
+
     namespace {
 
         /*  returns hypotenuse of real (non-complex) scalars a and b by
@@ -55,6 +59,8 @@ namespace QuantLib {
 
     }
 
+    #endif
+
 
     SVD::SVD(const Matrix& M) {
 
@@ -94,6 +100,34 @@ namespace QuantLib {
         s_ = Array(n_);
         U_ = Matrix(m_,n_, 0.0);
         V_ = Matrix(n_,n_);
+
+        #if defined(QL_USE_LAPACK)
+
+        /* The column-major view of A is A^T = V S U^T, which we
+           decompose as A^T = X S Y^T; hence V = X and U^T = Y^T.
+           The (n x m) column-major Y^T has the same layout as the
+           (m x n) row-major U.
+        */
+        Matrix X(n_, n_);
+        const int m = m_, n = n_;
+        int info = 0, lwork = -1;
+        double workSize = 0.0;
+        dgesvd_("A", "S", &n, &m, A.begin(), &n, s_.begin(),
+                X.begin(), &n, U_.begin(), &n,
+                &workSize, &lwork, &info);
+        QL_ENSURE(info == 0, "singular value decomposition workspace "
+                  "query failed (LAPACK info " << info << ")");
+        lwork = int(workSize);
+        std::vector<double> work(lwork);
+        dgesvd_("A", "S", &n, &m, A.begin(), &n, s_.begin(),
+                X.begin(), &n, U_.begin(), &n,
+                &work[0], &lwork, &info);
+        QL_ENSURE(info == 0, "singular value decomposition failed "
+                  "(LAPACK info " << info << ")");
+        V_ = transpose(X);
+
+        #else
+
         Array e(n_);
         Array work(m_);
         Integer i, j, k;
@@ -480,6 +514,8 @@ namespace QuantLib {
                 break;
             }
         }
+
+        #endif
     }
 
     const Matrix& SVD::U() const {
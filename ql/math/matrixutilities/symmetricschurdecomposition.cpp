@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -30,6 +31,34 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+
+        #if defined(QL_USE_LAPACK)
+
+        // s is symmetric, so its column-major view is s itself; the
+        // eigenvectors are returned as columns, i.e., as rows of the
+        // row-major matrix. They are sorted below.
+        Matrix a = s;
+        const int n = int(size);
+        int info = 0, lwork = -1, liwork = -1, iworkSize = 0;
+        double workSize = 0.0;
+        dsyevd_("V", "L", &n, a.begin(), &n, diagonal_.begin(),
+                &workSize, &lwork, &iworkSize, &liwork, &info);
+        QL_ENSURE(info == 0, "eigenvalue decomposition workspace query "
+                  "failed (LAPACK info " << info << ")");
+        lwork = int(workSize);
+        liwork = iworkSize;
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        dsyevd_("V", "L", &n, a.begin(), &n, diagonal_.begin(),
+                &work[0], &lwork, &iwork[0], &liwork, &info);
+        QL_ENSURE(info == 0, "eigenvalue decomposition failed "
+                  "(LAPACK info " << info << ")");
+        for (Size col=0; col<size; col++)
+            for (Size row=0; row<size; row++)
+                eigenVectors_[row][col] = a[col][row];
+
+        #else
+
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
             eigenVectors_[q][q] = 1.0;
@@ -111,6 +140,8 @@ namespace QuantLib {
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
 
+        #endif
+
 
         // sort (eigenvalues, eigenvectors)
         std::vector<std::pair<Real, std::vector<Real> > > temp(size);
@@ -50,6 +50,8 @@ namespace QuantLib {
                         const Array& values,
                         Array& newValues) const;
         \endcode
+        in order to provide a faster rollback step than the default
+        one, which goes through the above methods node by node.
 
         \ingroup lattices
     */
@@ -69,6 +71,11 @@ namespace QuantLib {
         //@{
         void initialize(DiscretizedAsset&, Time t) const;
         void rollback(DiscretizedAsset&, Time to) const;
+        /*! The assets are rolled back together one step at a time,
+            so that the data used by each step are shared among them.
+        */
+        void rollback(const std::vector<DiscretizedAsset*>& assets,
+                      Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const;
@@ -96,6 +103,7 @@ namespace QuantLib {
 
     template <class Impl>
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
+        statePrices_.reserve(until+1);
         for (Size i=statePricesLimit_; i<until; i++) {
             statePrices_.push_back(Array(this->impl().size(i+1), 0.0));
             for (Size j=0; j<this->impl().size(i); j++) {
@@ -156,13 +164,54 @@ namespace QuantLib {
             Array newValues(this->impl().size(i));
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    void TreeLattice<Impl>::rollback(
+                           const std::vector<DiscretizedAsset*>& assets,
+                           Time to) const {
+
+        if (assets.empty())
+            return;
+
+        Time from = assets[0]->time();
+        for (Size k=1; k<assets.size(); ++k)
+            QL_REQUIRE(close(assets[k]->time(), from),
+                       "asset #" << k+1 << " is at t = "
+                       << assets[k]->time() << " while the first one "
+                       "is at t = " << from);
+
+        if (!close(from,to)) {
+            QL_REQUIRE(from > to,
+                       "cannot roll the assets back to " << to
+                       << " (they are already at t = " << from << ")");
+
+            Integer iFrom = Integer(t_.index(from));
+            Integer iTo = Integer(t_.index(to));
+
+            for (Integer i=iFrom-1; i>=iTo; --i) {
+                for (Size k=0; k<assets.size(); ++k) {
+                    DiscretizedAsset& asset = *assets[k];
+                    Array newValues(this->impl().size(i));
+                    this->impl().stepback(i, asset.values(), newValues);
+                    asset.time() = t_[i];
+                    asset.values().swap(newValues);
+                    // skip the very last adjustment
+                    if (i != iTo)
+                        asset.adjustValues();
+                }
+            }
+        }
+
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
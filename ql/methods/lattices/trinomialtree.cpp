@@ -72,5 +72,22 @@ namespace QuantLib {
         }
     }
 
+    void TrinomialTree::Branching::stepback(const Real* discounts,
+                                            const Real* values,
+                                            Real* newValues) const {
+        const Integer* k = &k_[0];
+        const Real* p1 = &probs_[0][0];
+        const Real* p2 = &probs_[1][0];
+        const Real* p3 = &probs_[2][0];
+        // the lowest descendant of node j is k[j]-jMin_-1
+        const Integer offset = jMin_ + 1;
+        #pragma omp parallel for
+        for (long j=0; j<(long)k_.size(); j++) {
+            const Real* d = values + (k[j] - offset);
+            newValues[j] = (p1[j]*d[0] + p2[j]*d[1] + p3[j]*d[2])
+                         * discounts[j];
+        }
+    }
+
 }
 
@@ -52,6 +52,16 @@ namespace QuantLib {
         Real underlying(Size i, Size index) const;
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
+        //! discounted expectation at step i of values at step i+1
+        /*! For each node j at step i, sets newValues[j] to
+            discounts[j] times the sum over the branches of
+            probability(i,j,b)*values[descendant(i,j,b)].  The
+            branching data are stored in contiguous arrays, so this
+            is considerably faster than going through the methods
+            above node by node.
+        */
+        void stepback(Size i, const Real* discounts,
+                      const Real* values, Real* newValues) const;
 
       protected:
         std::vector<Branching> branchings_;
@@ -72,6 +82,8 @@ namespace QuantLib {
             Integer jMin() const;
             Integer jMax() const;
             void add(Integer k, Real p1, Real p2, Real p3);
+            void stepback(const Real* discounts,
+                          const Real* values, Real* newValues) const;
           private:
             std::vector<Integer> k_;
             std::vector<std::vector<Real> > probs_;
@@ -102,6 +114,12 @@ namespace QuantLib {
         return branchings_[i].probability(j, b);
     }
 
+    inline void TrinomialTree::stepback(Size i, const Real* discounts,
+                                        const Real* values,
+                                        Real* newValues) const {
+        branchings_[i].stepback(discounts, values, newValues);
+    }
+
     inline TrinomialTree::Branching::Branching()
     : probs_(3), kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
                  kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
@@ -48,8 +48,10 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
-      private:
+        //! simulates one path and returns its weight
         Real singlePathValues(std::vector<Real>& values);
+        Size numberOfValues() const { return numberProducts_; }
+      private:
 
         ext::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
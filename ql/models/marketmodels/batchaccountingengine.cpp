@@ -0,0 +1,129 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BatchAccountingEngine::BatchAccountingEngine(
+                     const ext::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue,
+                     Size batchSize)
+    : evolver_(evolver), product_(product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      batchSize_(batchSize),
+      curveState_(product->evolution().rateTimes()),
+      forwards_(product->evolution().numberOfRates()),
+      values_(product->numberOfProducts()),
+      numberCashFlowsThisStep_(product->numberOfProducts()),
+      cashFlowsGenerated_(product->numberOfProducts()) {
+        QL_REQUIRE(batchSize_>0, "batch size must be positive");
+
+        for (Size i=0; i<numberProducts_; ++i)
+            cashFlowsGenerated_[i].resize(
+                       product_->maxNumberOfCashFlowsPerProductPerStep());
+
+        const std::vector<Time>& cashFlowTimes =
+            product_->possibleCashFlowTimes();
+        const std::vector<Rate>& rateTimes = product_->evolution().rateTimes();
+        discounters_.reserve(cashFlowTimes.size());
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
+                                                         rateTimes));
+    }
+
+    void BatchAccountingEngine::batchValues(SequenceStatisticsInc& stats,
+                                            Size paths) {
+        if (products_.size() != paths) {
+            products_.assign(paths, product_);
+            principals_.resize(paths);
+            done_.resize(paths);
+            numerairesHeld_ = Matrix(paths, numberProducts_);
+        }
+
+        weights_ = evolver_->startNewPaths(paths);
+        for (Size p=0; p<paths; ++p)
+            products_[p]->reset();
+        std::fill(principals_.begin(), principals_.end(), 1.0);
+        std::fill(done_.begin(), done_.end(), false);
+        std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
+
+        Size pathsLeft = paths;
+        while (pathsLeft > 0) {
+            Size thisStep = evolver_->currentStep();
+            const std::vector<Real>& stepWeights = evolver_->advanceStep();
+            const Matrix& forwards = evolver_->currentForwards();
+            Size numeraire = evolver_->numeraires()[thisStep];
+
+            for (Size p=0; p<paths; ++p) {
+                if (done_[p])
+                    continue;
+
+                weights_[p] *= stepWeights[p];
+                std::copy(forwards.column_begin(p), forwards.column_end(p),
+                          forwards_.begin());
+                curveState_.setOnForwardRates(forwards_);
+
+                bool done = products_[p]->nextTimeStep(curveState_,
+                                                       numberCashFlowsThisStep_,
+                                                       cashFlowsGenerated_);
+
+                // convert the cash flows to numeraires as in
+                // AccountingEngine::singlePathValues
+                for (Size i=0; i<numberProducts_; ++i) {
+                    const std::vector<MarketModelMultiProduct::CashFlow>&
+                        cashflows = cashFlowsGenerated_[i];
+                    for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                        const MarketModelDiscounter& discounter =
+                            discounters_[cashflows[j].timeIndex];
+                        Real bonds = cashflows[j].amount *
+                            discounter.numeraireBonds(curveState_, numeraire);
+                        numerairesHeld_[p][i] += bonds/principals_[p];
+                    }
+                }
+
+                if (done) {
+                    done_[p] = true;
+                    --pathsLeft;
+                } else {
+                    Size nextNumeraire = evolver_->numeraires()[thisStep+1];
+                    principals_[p] *=
+                        curveState_.discountRatio(numeraire, nextNumeraire);
+                }
+            }
+        }
+
+        for (Size p=0; p<paths; ++p) {
+            for (Size i=0; i<numberProducts_; ++i)
+                values_[i] = numerairesHeld_[p][i] * initialNumeraireValue_;
+            stats.add(values_, weights_[p]);
+        }
+    }
+
+    void BatchAccountingEngine::multiplePathValues(
+                                               SequenceStatisticsInc& stats,
+                                               Size numberOfPaths) {
+        for (Size i=0; i<numberOfPaths; i+=batchSize_)
+            batchValues(stats, std::min(batchSize_, numberOfPaths-i));
+    }
+
+}
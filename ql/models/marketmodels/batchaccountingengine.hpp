@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchaccountingengine.hpp
+    \brief Accounting engine for batch market-model evolvers
+*/
+
+#ifndef quantlib_batch_accounting_engine_hpp
+#define quantlib_batch_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/discounter.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/utilities/clone.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class MarketModelBatchEvolver;
+
+    //! Engine collecting cash flows along a batched market-model simulation
+    /*! Paths are evolved in batches of the given size; each path
+        carries its own copy of the product.  Results are added to
+        the statistics in path order, so that they reproduce those of
+        AccountingEngine when the evolvers are driven by the same
+        Brownian generator.
+    */
+    class BatchAccountingEngine {
+      public:
+        BatchAccountingEngine(
+                     const ext::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue,
+                     Size batchSize = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        void batchValues(SequenceStatisticsInc& stats, Size paths);
+
+        ext::shared_ptr<MarketModelBatchEvolver> evolver_;
+        Clone<MarketModelMultiProduct> product_;
+
+        Real initialNumeraireValue_;
+        Size numberProducts_, batchSize_;
+
+        // workspace
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+        LMMCurveState curveState_;
+        std::vector<Rate> forwards_;
+        std::vector<Real> weights_, principals_, values_;
+        std::vector<bool> done_;
+        Matrix numerairesHeld_;
+        std::vector<Size> numberCashFlowsThisStep_;
+        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated_;
+        std::vector<MarketModelDiscounter> discounters_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchevolver.hpp
+    \brief Market-model evolver working on batches of paths
+*/
+
+#ifndef quantlib_market_model_batch_evolver_hpp
+#define quantlib_market_model_batch_evolver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class CurveState;
+
+    //! Market-model evolver working on batches of paths
+    /*! Abstract base class. Like MarketModelEvolver, but evolving a
+        number of paths at the same time. Rates are stored with one
+        row per rate and one column per path, so that the work for
+        a given rate is done on contiguous memory and can be
+        vectorized by the compiler.
+    */
+    class MarketModelBatchEvolver {
+      public:
+        virtual ~MarketModelBatchEvolver() {}
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        //! starts a new batch and returns the weights of its paths
+        virtual const std::vector<Real>& startNewPaths(Size paths) = 0;
+        //! advances all paths and returns the weights for the step
+        virtual const std::vector<Real>& advanceStep() = 0;
+        virtual Size currentStep() const = 0;
+        virtual Size numberOfPaths() const = 0;
+        //! forward rates (one row per rate, one column per path)
+        virtual const Matrix& currentForwards() const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
+    };
+
+}
+
+#endif
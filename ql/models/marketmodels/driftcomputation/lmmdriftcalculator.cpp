@@ -181,4 +181,90 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "numberOfRates <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==forwards.columns(),
+                   "drifts size mismatch");
+
+        Size paths = forwards.columns();
+        if (batchTmp_.rows()!=numberOfRates_ || batchTmp_.columns()!=paths) {
+            batchTmp_ = Matrix(numberOfRates_, paths, 0.0);
+            batchE_ = Matrix(numberOfFactors_, paths, 0.0);
+            batchSum_.resize(paths);
+        }
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Real d = displacements_[i], oneOverTau = oneOverTaus_[i];
+            const Real* f = forwards.row_begin(i);
+            Real* t = batchTmp_.row_begin(i);
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+d)/(oneOverTau+f[p]);
+        }
+
+        if (isFullFactor_) {
+            // same summation as the inner product in computePlain
+            for (Size i=alive_; i<numberOfRates_; ++i) {
+                std::fill(batchSum_.begin(), batchSum_.end(), 0.0);
+                for (Size k=downs_[i]; k<ups_[i]; ++k) {
+                    Real c = C_[i][k];
+                    const Real* t = batchTmp_.row_begin(k);
+                    for (Size p=0; p<paths; ++p)
+                        batchSum_[p] += t[p]*c;
+                }
+                Real* d = drifts.row_begin(i);
+                if (numeraire_>i+1) {
+                    for (Size p=0; p<paths; ++p)
+                        d[p] = -batchSum_[p];
+                } else {
+                    std::copy(batchSum_.begin(), batchSum_.end(), d);
+                }
+            }
+            return;
+        }
+
+        // Reduced-factor case: as in computeReduced, but each e_[r][i]
+        // only depends on its neighbour, so one row per factor is
+        // enough, updated in place while moving away from the numeraire.
+
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        std::fill(batchE_.begin(), batchE_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            const Real* t = batchTmp_.row_begin(i+1);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                Real* e = batchE_.row_begin(r);
+                for (Size p=0; p<paths; ++p) {
+                    e[p] = e[p] + t[p]*a;
+                    d[p] -= e[p]*b;
+                }
+            }
+        }
+
+        std::fill(batchE_.begin(), batchE_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            const Real* t = batchTmp_.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i][r];
+                Real* e = batchE_.row_begin(r);
+                for (Size p=0; p<paths; ++p) {
+                    e[p] = e[p] + t[p]*a;
+                    d[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
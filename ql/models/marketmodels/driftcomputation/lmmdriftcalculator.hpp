@@ -64,6 +64,15 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts for a batch of paths; forwards and
+            drifts are stored with one row per rate and one column
+            per path, so that the inner loops run over contiguous
+            memory. The results are the same as those obtained by
+            calling compute() on each path in turn.
+        */
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +83,8 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix batchTmp_, batchE_;
+        mutable std::vector<Real> batchSum_;
         std::vector<Size> downs_, ups_;
     };
 
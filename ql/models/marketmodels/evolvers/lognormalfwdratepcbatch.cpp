@@ -0,0 +1,209 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    LogNormalFwdRatePcBatch::LogNormalFwdRatePcBatch(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      numberOfPaths_(0),
+      displacements_(marketModel->displacements()),
+      initialForwards_(numberOfRates_),
+      initialLogForwards_(numberOfRates_),
+      initialDrifts_(numberOfRates_), brownian_(numberOfFactors_),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        generator_ = factory.create(numberOfFactors_, steps-initialStep_);
+
+        currentStep_ = initialStep_;
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        brownians_.resize(steps-initialStep_);
+        stepWeights_.resize(steps-initialStep_);
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& LogNormalFwdRatePcBatch::numeraires() const {
+        return numeraires_;
+    }
+
+    void LogNormalFwdRatePcBatch::setForwards(
+                                          const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        std::copy(forwards.begin(), forwards.end(), initialForwards_.begin());
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void LogNormalFwdRatePcBatch::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    const std::vector<Real>& LogNormalFwdRatePcBatch::startNewPaths(
+                                                                Size paths) {
+        QL_REQUIRE(paths>0, "at least one path required");
+        if (paths != numberOfPaths_) {
+            numberOfPaths_ = paths;
+            forwards_ = Matrix(numberOfRates_, paths, 0.0);
+            logForwards_ = Matrix(numberOfRates_, paths, 0.0);
+            drifts1_ = Matrix(numberOfRates_, paths, 0.0);
+            drifts2_ = Matrix(numberOfRates_, paths, 0.0);
+            weights_.resize(paths);
+            for (Size s=0; s<brownians_.size(); ++s) {
+                brownians_[s] = Matrix(numberOfFactors_, paths, 0.0);
+                stepWeights_[s].resize(paths);
+            }
+        }
+
+        // draw the variates path by path, so that each path sees the
+        // same sequence as it would in the single-path evolver
+        for (Size p=0; p<paths; ++p) {
+            weights_[p] = generator_->nextPath();
+            for (Size s=0; s<brownians_.size(); ++s) {
+                stepWeights_[s][p] = generator_->nextStep(brownian_);
+                for (Size f=0; f<numberOfFactors_; ++f)
+                    brownians_[s][f][p] = brownian_[f];
+            }
+        }
+
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialForwards_[i]);
+        }
+        return weights_;
+    }
+
+    const std::vector<Real>& LogNormalFwdRatePcBatch::advanceStep()
+    {
+        // we're going from T1 to T2
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(forwards_, drifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        const Matrix& brownians = brownians_[currentStep_-initialStep_];
+
+        Size i, p, alive = alive_[currentStep_];
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* logF = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            // f is used as workspace for the correlated increment
+            std::fill(f, f+numberOfPaths_, 0.0);
+            for (Size k=0; k<numberOfFactors_; ++k) {
+                Real a = A[i][k];
+                const Real* z = brownians.row_begin(k);
+                for (p=0; p<numberOfPaths_; ++p)
+                    f[p] += a*z[p];
+            }
+            Real fixed = fixedDrift[i], displacement = displacements_[i];
+            for (p=0; p<numberOfPaths_; ++p) {
+                logF[p] += d1[p] + fixed;
+                logF[p] += f[p];
+                f[p] = std::exp(logF[p]) - displacement;
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(forwards_, drifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* logF = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real* d2 = drifts2_.row_begin(i);
+            Real displacement = displacements_[i];
+            for (p=0; p<numberOfPaths_; ++p) {
+                logF[p] += (d2[p]-d1[p])/2.0;
+                f[p] = std::exp(logF[p]) - displacement;
+            }
+        }
+
+        const std::vector<Real>& weights =
+            stepWeights_[currentStep_-initialStep_];
+
+        ++currentStep_;
+
+        return weights;
+    }
+
+    Size LogNormalFwdRatePcBatch::currentStep() const {
+        return currentStep_;
+    }
+
+    Size LogNormalFwdRatePcBatch::numberOfPaths() const {
+        return numberOfPaths_;
+    }
+
+    const Matrix& LogNormalFwdRatePcBatch::currentForwards() const {
+        return forwards_;
+    }
+
+}
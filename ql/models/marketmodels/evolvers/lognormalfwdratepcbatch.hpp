@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_forward_rate_pc_batch_evolver_hpp
+#define quantlib_forward_rate_pc_batch_evolver_hpp
+
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector on batches of paths
+    /*! Gives the same paths as LogNormalFwdRatePc when driven by
+        the same Brownian generator, since the variates for each path
+        are drawn in the same order.
+    */
+    class LogNormalFwdRatePcBatch : public MarketModelBatchEvolver {
+      public:
+        LogNormalFwdRatePcBatch(const ext::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size initialStep = 0);
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        const std::vector<Real>& startNewPaths(Size paths);
+        const std::vector<Real>& advanceStep();
+        Size currentStep() const;
+        Size numberOfPaths() const;
+        const Matrix& currentForwards() const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        // inputs
+        ext::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+        ext::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, numberOfPaths_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialForwards_, initialLogForwards_;
+        std::vector<Real> initialDrifts_;
+        Matrix forwards_, logForwards_, drifts1_, drifts2_;
+        std::vector<Matrix> brownians_;
+        std::vector<Real> weights_, brownian_;
+        std::vector<std::vector<Real> > stepWeights_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
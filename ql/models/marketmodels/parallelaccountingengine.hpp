@@ -0,0 +1,200 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief Parallel driver for market-model accounting engines
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/shared_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Parallel driver for market-model accounting engines
+    /*! The paths are split among a number of streams, each simulated
+        by its own engine.  Every engine must own its evolver, Brownian
+        generator and product, and the generators must provide
+        independent sequences (e.g., Mersenne-Twister generators with
+        different seeds); the market model can be shared, since it is
+        only read during the simulation.
+
+        Streams are run in parallel when OpenMP is enabled.  Path
+        values are collected in blocks and added to the statistics in
+        stream order, so that results don't depend on the number of
+        threads.
+
+        The Engine class must provide the
+        <tt>Real singlePathValues(std::vector<Real>&)</tt> and
+        <tt>Size numberOfValues() const</tt> methods, as
+        AccountingEngine and the pathwise accounting engines do.
+    */
+    template <class Engine>
+    class ParallelAccountingEngine {
+      public:
+        /*! \param engines    one engine per stream.
+            \param blockSize  number of paths simulated by each stream
+                              before results are collected.
+        */
+        explicit ParallelAccountingEngine(
+                       const std::vector<ext::shared_ptr<Engine> >& engines,
+                       Size blockSize = 1024);
+        //! adds the weighted path values to the statistics
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! unweighted means and errors, as in the pathwise vega engines
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+        Size numberOfStreams() const { return engines_.size(); }
+      private:
+        Size pathsForStream(Size i, Size numberOfPaths) const;
+        std::vector<ext::shared_ptr<Engine> > engines_;
+        Size blockSize_, numberOfValues_;
+    };
+
+
+    // template definitions
+
+    template <class Engine>
+    ParallelAccountingEngine<Engine>::ParallelAccountingEngine(
+                       const std::vector<ext::shared_ptr<Engine> >& engines,
+                       Size blockSize)
+    : engines_(engines), blockSize_(blockSize) {
+        QL_REQUIRE(!engines_.empty(), "no engines given");
+        QL_REQUIRE(blockSize_ > 0, "block size must be positive");
+        numberOfValues_ = engines_.front()->numberOfValues();
+        for (Size i=1; i<engines_.size(); ++i)
+            QL_REQUIRE(engines_[i]->numberOfValues() == numberOfValues_,
+                       "engines return different numbers of values");
+    }
+
+    template <class Engine>
+    Size ParallelAccountingEngine<Engine>::pathsForStream(
+                                        Size i, Size numberOfPaths) const {
+        Size n = engines_.size();
+        return numberOfPaths/n + (i < numberOfPaths%n ? 1 : 0);
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                                               SequenceStatisticsInc& stats,
+                                               Size numberOfPaths) {
+        Size n = engines_.size();
+        std::vector<Size> remaining(n), block(n);
+        for (Size i=0; i<n; ++i)
+            remaining[i] = pathsForStream(i, numberOfPaths);
+        std::vector<Matrix> values(n);
+        std::vector<std::vector<Real> > weights(n);
+        std::vector<std::string> errors(n);
+
+        for (;;) {
+            bool done = true;
+            for (Size i=0; i<n; ++i) {
+                block[i] = std::min(blockSize_, remaining[i]);
+                if (block[i] > 0)
+                    done = false;
+                if (values[i].rows() < block[i]) {
+                    values[i] = Matrix(block[i], numberOfValues_);
+                    weights[i].resize(block[i]);
+                }
+            }
+            if (done)
+                break;
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long i=0; i<(long)n; ++i) {
+                try {
+                    std::vector<Real> pathValues(numberOfValues_);
+                    for (Size j=0; j<block[i]; ++j) {
+                        weights[i][j] =
+                            engines_[i]->singlePathValues(pathValues);
+                        std::copy(pathValues.begin(), pathValues.end(),
+                                  values[i].row_begin(j));
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(errors[i].empty(),
+                           "stream " << i << " failed: " << errors[i]);
+                for (Size j=0; j<block[i]; ++j)
+                    stats.add(values[i].row_begin(j), values[i].row_end(j),
+                              weights[i][j]);
+                remaining[i] -= block[i];
+            }
+        }
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                                                    std::vector<Real>& means,
+                                                    std::vector<Real>& errors,
+                                                    Size numberOfPaths) {
+        QL_REQUIRE(numberOfPaths > 0, "at least one path required");
+        Size n = engines_.size();
+        std::vector<std::vector<Real> > sums(n), sumsqs(n);
+        std::vector<std::string> failures(n);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                std::vector<Real> pathValues(numberOfValues_);
+                sums[i].resize(numberOfValues_, 0.0);
+                sumsqs[i].resize(numberOfValues_, 0.0);
+                Size paths = pathsForStream(i, numberOfPaths);
+                for (Size j=0; j<paths; ++j) {
+                    engines_[i]->singlePathValues(pathValues);
+                    for (Size k=0; k<numberOfValues_; ++k) {
+                        sums[i][k] += pathValues[k];
+                        sumsqs[i][k] += pathValues[k]*pathValues[k];
+                    }
+                }
+            } catch (std::exception& e) {
+                failures[i] = e.what();
+            }
+        }
+
+        means.resize(numberOfValues_);
+        errors.resize(numberOfValues_);
+        for (Size k=0; k<numberOfValues_; ++k) {
+            Real sum = 0.0, sumsq = 0.0;
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(failures[i].empty(),
+                           "stream " << i << " failed: " << failures[i]);
+                sum += sums[i][k];
+                sumsq += sumsqs[i][k];
+            }
+            means[k] = sum/numberOfPaths;
+            Real meanSq = sumsq/numberOfPaths;
+            Real variance = meanSq - means[k]*means[k];
+            errors[k] = std::sqrt(variance/numberOfPaths);
+        }
+    }
+
+}
+
+#endif
@@ -751,23 +751,21 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
-       std::vector<Matrix> jacobiansThisPathsModel;
-       for (Size i =0; i < numberRates_; ++i)
-              jacobiansThisPathsModel.push_back(Matrix(numberRates_,factors_));
-
-
-
         for (Size i =0; i < numberSteps_; ++i)
         {
               jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
                                 pseudoRootStructure_->displacements()));
-
-              // vector of vector of matrices to store jacobians of rates with respect to pseudo-root elements
-            jacobiansThisPaths_.push_back(jacobiansThisPathsModel);
         }
 
+        // the path is recorded during the forward pass, and the elementary vegas
+        // are obtained from it by a single adjoint sweep once V is known
+        forwardsThisPath_.resize(numberSteps_+1, std::vector<Real>(numberRates_));
+        stepsDiscountsThisPath_.resize(numberSteps_, std::vector<Real>(numberRates_+1));
+        browniansThisPath_.resize(numberSteps_, std::vector<Real>(factors_));
+        rateSensitivities_.resize(numberRates_);
+
 
 
         Matrix VModel(numberSteps_+1,numberRates_);
@@ -873,6 +871,7 @@ namespace QuantLib {
 
         const std::vector<Real>& initialForwards_(pseudoRootStructure_->initialRates());
         currentForwards_ = initialForwards_;
+        forwardsThisPath_[0] = currentForwards_;
         // clear accumulation variables
         for (Size i=0; i < numberProducts_; ++i)
         {
@@ -924,11 +923,9 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
+            forwardsThisPath_[storeStep] = currentForwards_;
+            stepsDiscountsThisPath_[thisStep] = stepsDiscounts_;
+            browniansThisPath_[thisStep] = evolver_->browniansThisStep();
 
 //            gaussians_[thisStep] = evolver_->browniansThisStep();
 
@@ -1070,29 +1067,23 @@ namespace QuantLib {
         {
                 for (Size j=0; j < numberSteps_; ++j)
                 {
-                    Size nextIndex = j+1;
+                    // steps after the product was done have no effect on its value
+                    if (static_cast<Integer>(j) > finalStepDone)
+                    {
+                        std::fill(elementary_vegas_ThisPath_[i][j].begin(), elementary_vegas_ThisPath_[i][j].end(), 0.0);
+                        continue;
+                    }
 
                     // we know V, we need to pair against the senstivity of the rate to the elementary vega
                     // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
-
-                    for (Size k=0; k < numberRates_; ++k)
-                        for (Size f=0; f < factors_; ++f)
-                        {
-                                Real sensitivity =0.0;
-
-                                for (Size r=0; r < numberRates_; ++r)
-                                {
-                                        sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
-
-                                  }
-/*
-                                  if (j ==distinguishedStep_ && k ==distinguishedRate_ &&f== distinguishedFactor_)
-                                      std::cout << sensitivity << "," <<  jacobiansThisPaths_[j][j][k][f] << "," << gaussians_[j][f] << "," << V_[i][nextIndex][j] << "," << LIBORRates_[nextIndex][j] << "\n";
-  */                
-
-
-                                elementary_vegas_ThisPath_[i][j][k][f] = sensitivity;
-                        }
+                    std::copy(V_[i].row_begin(j+1), V_[i].row_end(j+1), rateSensitivities_.begin());
+
+                    jacobianComputers_[j].getVegas(forwardsThisPath_[j],
+                                                   stepsDiscountsThisPath_[j],
+                                                   forwardsThisPath_[j+1],
+                                                   browniansThisPath_[j],
+                                                   rateSensitivities_,
+                                                   elementary_vegas_ThisPath_[i][j]);
                 }
         }
 
@@ -1160,6 +1151,15 @@ namespace QuantLib {
 
             multiplePathValuesElementary(allMeans,allErrors,numberOfPaths);
 
+            combineElementaryVegas(allMeans,allErrors,means,errors);
+
+        } // end of method
+
+        void PathwiseVegasOuterAccountingEngine::combineElementaryVegas(const std::vector<Real>& allMeans,
+                                                                        const std::vector<Real>& allErrors,
+                                                                        std::vector<Real>& means,
+                                                                        std::vector<Real>& errors) const
+        {
             Size outDataPerProduct = 1+numberRates_+numberBumps_;
             Size inDataPerProduct = 1+numberRates_+numberElementaryVegas_;
 
@@ -51,8 +51,13 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! simulates one path and returns its weight
+        Real singlePathValues(std::vector<Real>& values);
+        //! values per path: price and deltas for each product
+        Size numberOfValues() const {
+            return numberProducts_*(numberRates_+1);
+        }
       private:
-          Real singlePathValues(std::vector<Real>& values);
 
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -122,8 +127,13 @@ namespace QuantLib {
         void multiplePathValues(std::vector<Real>& means,
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
+        //! simulates one path and returns its weight
+        Real singlePathValues(std::vector<Real>& values);
+        //! values per path: price, deltas and vegas for each product
+        Size numberOfValues() const {
+            return numberProducts_*(1+numberRates_+numberBumps_);
+        }
       private:
-          Real singlePathValues(std::vector<Real>& values);
 
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -208,8 +218,20 @@ namespace QuantLib {
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
 
+        //! Combines the results of multiplePathValuesElementary into vegas with respect to VegaBumps
+        void combineElementaryVegas(const std::vector<Real>& allMeans,
+                                    const std::vector<Real>& allErrors,
+                                    std::vector<Real>& means,
+                                    std::vector<Real>& errors) const;
+
+        //! simulates one path (elementary vegas) and returns its weight
+        Real singlePathValues(std::vector<Real>& values);
+        //! values per path: price, deltas and elementary vegas for each product
+        Size numberOfValues() const {
+            return numberProducts_*(1+numberRates_+numberElementaryVegas_);
+        }
+
       private:
-          Real singlePathValues(std::vector<Real>& values);
 
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -252,7 +274,12 @@ namespace QuantLib {
         Matrix partials_; // dimensions are factor and rate
 
         std::vector<std::vector<Matrix>   > elementary_vegas_ThisPath_;  // dimensions are product, step,  rate and factor
-        std::vector<std::vector<Matrix> > jacobiansThisPaths_;                      // dimensions are step, rate, rate and factor
+
+        // recorded along the path for the adjoint computation of the elementary vegas
+        std::vector<std::vector<Real> > forwardsThisPath_;        // dimensions are step+1 and rate
+        std::vector<std::vector<Real> > stepsDiscountsThisPath_;  // dimensions are step and rate+1
+        std::vector<std::vector<Real> > browniansThisPath_;       // dimensions are step and factor
+        std::vector<Real> rateSensitivities_;
 
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
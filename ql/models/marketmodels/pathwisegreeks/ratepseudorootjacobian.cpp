@@ -330,6 +330,56 @@ namespace QuantLib
             }
     }
 
+    void RatePseudoRootJacobianAllElements::getVegas(const std::vector<Rate>& oldRates,
+        const std::vector<Real>& discountRatios,
+        const std::vector<Rate>& newRates,
+        const std::vector<Real>& gaussians,
+        const std::vector<Real>& rateSensitivities,
+        Matrix& vegas)
+    {
+        Size numberRates = taus_.size();
+
+        QL_REQUIRE(rateSensitivities.size() == numberRates, "we need rateSensitivities.size() which is " << rateSensitivities.size() << " to equal numberRates which is "  << numberRates);
+        QL_REQUIRE(vegas.columns() == factors_ && vegas.rows() == numberRates , "we need vegas.rows() which is " << vegas.rows() << " to equal numberRates which is "  << numberRates <<
+            " and vegas.columns() which is " << vegas.columns() << " to be equal to factors which is " << factors_);
+
+        for (Size j=aliveIndex_; j < numberRates; ++j)
+            ratios_[j] = (oldRates[j] + displacements_[j])*discountRatios[j+1];
+
+        // rates that have already reset are not sensitive to the pseudo-root
+        for (Size k=0; k < aliveIndex_; ++k)
+            for (Size f=0; f < factors_; ++f)
+                vegas[k][f] = 0.0;
+
+        for (Size f=0; f < factors_; ++f)
+        {
+            // B[j][k][f] for j > k only depends on j through newRates[j]*pseudoRoot_[j][f],
+            // so the off-diagonal part of the sum is accumulated backwards...
+            Real laterRates = 0.0;
+            for (Size k=numberRates; k > aliveIndex_; --k)
+            {
+                vegas[k-1][f] = laterRates;
+                laterRates += rateSensitivities[k-1]*newRates[k-1]*pseudoRoot_[k-1][f];
+            }
+
+            // ...and the diagonal part, which needs the e_ of getBumps, forwards
+            Real e = 0.0;
+            for (Size k=aliveIndex_; k < numberRates; ++k)
+            {
+                if (k > aliveIndex_)
+                    e += ratios_[k-1]*pseudoRoot_[k-1][f];
+
+                Real tmp = 2*ratios_[k]*taus_[k]*pseudoRoot_[k][f];
+                tmp -=  pseudoRoot_[k][f];
+                tmp += e*taus_[k];
+                tmp += gaussians[f];
+                tmp *= (newRates[k]+displacements_[k]);
+
+                vegas[k][f] = rateSensitivities[k]*tmp + ratios_[k]*taus_[k]*vegas[k][f];
+            }
+        }
+    }
+
     
 }
 
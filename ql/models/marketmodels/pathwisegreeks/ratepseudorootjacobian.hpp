@@ -129,6 +129,15 @@ namespace QuantLib
             const std::vector<Real>& gaussians,
             std::vector<Matrix>& B); // one Matrix for each rate, the elements of the matrix are the derivatives of that rate with respect to each pseudo-root element
 
+        // adjoint version of getBumps: returns sum_j rateSensitivities[j]*B[j] directly,
+        // at a cost of O(rates*factors) rather than O(rates*rates*factors)
+        void getVegas(const std::vector<Rate>& oldRates,
+            const std::vector<Real>& oneStepDFs,
+            const std::vector<Rate>& newRates,
+            const std::vector<Real>& gaussians,
+            const std::vector<Real>& rateSensitivities, // derivatives of the path value with respect to the new rates
+            Matrix& vegas); // derivatives of the path value with respect to each pseudo-root element
+
     private:
 
         //! this data does not change after construction
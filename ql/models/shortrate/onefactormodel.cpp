@@ -64,7 +64,8 @@ namespace QuantLib {
                 <TermStructureFittingParameter::NumericalImpl>& theta,
             const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
-      tree_(tree), dynamics_(dynamics), spread_(0.0) {
+      tree_(tree), dynamics_(dynamics), spread_(0.0),
+      discounts_(timeGrid.size() - 1) {
 
         theta->reset();
         Real value = 1.0;
@@ -87,7 +88,26 @@ namespace QuantLib {
                          const ext::shared_ptr<ShortRateDynamics>& dynamics,
                          const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
-      tree_(tree), dynamics_(dynamics), spread_(0.0) {}
+      tree_(tree), dynamics_(dynamics), spread_(0.0),
+      discounts_(timeGrid.size() - 1) {}
+
+    const Array& OneFactorModel::ShortRateTree::discounts(Size i) const {
+        Array& d = discounts_[i];
+        if (d.empty()) {
+            Array tmp(size(i));
+            for (Size j=0; j<tmp.size(); ++j)
+                tmp[j] = discount(i, j);
+            d.swap(tmp);
+        }
+        return d;
+    }
+
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        tree_->stepback(i, discounts(i).begin(),
+                        values.begin(), newValues.begin());
+    }
 
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
@@ -103,15 +103,27 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        /*! The discount factors at each step are calculated the
+            first time the step is used and cached; the cache is
+            cleared when the spread changes.
+        */
+        void stepback(Size i,
+                      const Array& values,
+                      Array& newValues) const;
         void setSpread(Spread spread)
         {
-            spread_=spread;
+            if (spread != spread_) {
+                spread_=spread;
+                discounts_ = std::vector<Array>(discounts_.size());
+            }
         }
       private:
+        const Array& discounts(Size i) const;
         ext::shared_ptr<TrinomialTree> tree_;
         ext::shared_ptr<ShortRateDynamics> dynamics_;
         class Helper;
         Spread spread_;
+        mutable std::vector<Array> discounts_;
     };
 
     //! Single-factor affine base class
@@ -52,6 +52,92 @@ Real Gaussian1dModel::forwardRate(const Date &fixing,
            (dcf * zerobond(endDate, referenceDate, y, yts));
 }
 
+const Disposable<Array>
+Gaussian1dModel::zerobondGrid(const Time T, const Time t, const Real yStdDevs,
+                              const int gridPoints,
+                              const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    CachedGridKey k = {T, t, yStdDevs, gridPoints};
+    if (yts.empty()) {
+        GridCacheType::const_iterator i = gridCache_.find(k);
+        if (i != gridCache_.end()) {
+            Array result(i->second);
+            return result;
+        }
+    }
+
+    Array z = yGrid(yStdDevs, gridPoints);
+    Array result(z.size());
+    for (Size i = 0; i < z.size(); ++i)
+        result[i] = zerobond(T, t, z[i], yts);
+
+    if (yts.empty())
+        gridCache_.insert(std::make_pair(k, result));
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::numeraireGrid(const Time t, const Real yStdDevs,
+                               const int gridPoints,
+                               const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    CachedGridKey k = {Null<Time>(), t, yStdDevs, gridPoints};
+    if (yts.empty()) {
+        GridCacheType::const_iterator i = gridCache_.find(k);
+        if (i != gridCache_.end()) {
+            Array result(i->second);
+            return result;
+        }
+    }
+
+    Array z = yGrid(yStdDevs, gridPoints);
+    Array result(z.size());
+    for (Size i = 0; i < z.size(); ++i)
+        result[i] = numeraire(t, z[i], yts);
+
+    if (yts.empty())
+        gridCache_.insert(std::make_pair(k, result));
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::forwardRateGrid(const Date &fixing, const Date &referenceDate,
+                                 const Real yStdDevs, const int gridPoints,
+                                 ext::shared_ptr<IborIndex> iborIdx) const {
+
+    QL_REQUIRE(iborIdx != NULL, "no ibor index given");
+
+    calculate();
+
+    if (fixing <= (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1))) {
+        Array result(2 * gridPoints + 1, iborIdx->fixing(fixing));
+        return result;
+    }
+
+    Handle<YieldTermStructure> yts =
+        iborIdx->forwardingTermStructure(); // might be empty, then use
+                                            // model curve
+
+    Date valueDate = iborIdx->valueDate(fixing);
+    Date endDate = iborIdx->fixingCalendar().advance(
+        valueDate, iborIdx->tenor(), iborIdx->businessDayConvention(),
+        iborIdx->endOfMonth());
+    // FIXME Here we should use the calculation date calendar ?
+    Real dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
+
+    Array d0 = zerobondGrid(valueDate, referenceDate, yStdDevs, gridPoints, yts);
+    Array d1 = zerobondGrid(endDate, referenceDate, yStdDevs, gridPoints, yts);
+
+    Array result(d0.size());
+    for (Size i = 0; i < result.size(); ++i)
+        result[i] = (d0[i] - d1[i]) / (dcf * d1[i]);
+    return result;
+}
+
 Real Gaussian1dModel::swapRate(const Date &fixing, const Period &tenor,
                                const Date &referenceDate, const Real y,
                                ext::shared_ptr<SwapIndex> swapIdx) const {
@@ -94,6 +94,32 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         const Real y = 0.0,
         const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
 
+    /*! Zerobond prices, numeraires and forward rates conditional on
+        the state variable at the reference time taking the values
+        of the standardized grid yGrid(yStdDevs, gridPoints). The
+        results w.r.t. the model curve are cached until the model
+        changes, so that engines pricing e.g. the swaptions of a
+        calibration basket share them. Results w.r.t. an explicitly
+        given curve are not cached, since the model is not notified
+        of changes in that curve. */
+    const Disposable<Array> zerobondGrid(
+        const Time T, const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    const Disposable<Array> zerobondGrid(
+        const Date &maturity, const Date &referenceDate, const Real yStdDevs,
+        const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    const Disposable<Array> numeraireGrid(
+        const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    const Disposable<Array> forwardRateGrid(
+        const Date &fixing, const Date &referenceDate, const Real yStdDevs,
+        const int gridPoints,
+        ext::shared_ptr<IborIndex> iborIdx = ext::shared_ptr<IborIndex>()) const;
+
     Real zerobondOption(
         const Option::Type &type, const Date &expiry, const Date &valueDate,
         const Date &maturity, const Rate strike,
@@ -180,6 +206,35 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // Zerobond and numeraire values on the standardized state grid. The
+    // numeraire is stored with a null maturity.
+
+    struct CachedGridKey {
+        const Time T, t;
+        const Real yStdDevs;
+        const int gridPoints;
+        bool operator==(const CachedGridKey &o) const {
+            return T == o.T && t == o.t && yStdDevs == o.yStdDevs &&
+                   gridPoints == o.gridPoints;
+        }
+    };
+
+    struct CachedGridKeyHasher {
+        std::size_t operator()(CachedGridKey const &x) const {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, x.T);
+            boost::hash_combine(seed, x.t);
+            boost::hash_combine(seed, x.yStdDevs);
+            boost::hash_combine(seed, x.gridPoints);
+            return seed;
+        }
+    };
+
+    typedef boost::unordered_map<CachedGridKey, Array, CachedGridKeyHasher>
+        GridCacheType;
+
+    mutable GridCacheType gridCache_;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -200,8 +255,13 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        flushGridCache();
     }
 
+    // derived classes must call this whenever the model changes
+    // without going through performCalculations
+    void flushGridCache() const { gridCache_.clear(); }
+
     void generateArguments() {
         calculate();
         notifyObservers();
@@ -266,6 +326,18 @@ Gaussian1dModel::zerobond(const Date &maturity, const Date &referenceDate,
                         : 0.0,
                     y, yts);
 }
+
+inline const Disposable<Array>
+Gaussian1dModel::zerobondGrid(const Date &maturity, const Date &referenceDate,
+                              const Real yStdDevs, const int gridPoints,
+                              const Handle<YieldTermStructure> &yts) const {
+
+    return zerobondGrid(termStructure()->timeFromReference(maturity),
+                        referenceDate != Null<Date>()
+                            ? termStructure()->timeFromReference(referenceDate)
+                            : 0.0,
+                        yStdDevs, gridPoints, yts);
+}
 }
 
 #endif
@@ -141,6 +141,7 @@ class Gsr : public Gaussian1dModel, public CalibratedModel {
 
     void generateArguments() {
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
+        flushGridCache();
         notifyObservers();
     }
 
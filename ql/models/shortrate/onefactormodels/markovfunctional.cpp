@@ -461,11 +461,59 @@ namespace QuantLib {
         }
     }
 
+    const Disposable<std::vector<Real> >
+    MarkovFunctional::tabulationInputs(const CalibrationPoint &p,
+                                       const Size idx) const {
+
+        std::vector<Real> inputs;
+        inputs.push_back(times_[idx]);
+        inputs.push_back(p.atm_);
+        inputs.push_back(p.annuity_);
+        inputs.push_back(termStructure()->discount(times_[idx], true));
+        for (Size k = 0; k < p.paymentDates_.size(); ++k)
+            inputs.push_back(
+                termStructure()->discount(p.paymentDates_[k], true));
+        SmileSectionUtils ssutils(*p.rawSmileSection_,
+                                  modelSettings_.smileMoneynessCheckpoints_,
+                                  p.atm_);
+        inputs.insert(inputs.end(), ssutils.strikeGrid().begin(),
+                      ssutils.strikeGrid().end());
+        inputs.insert(inputs.end(), ssutils.callPrices().begin(),
+                      ssutils.callPrices().end());
+        return inputs;
+    }
+
     void MarkovFunctional::updateNumeraireTabulation() const {
 
         QL_MFMESSAGE(modelOutputs_, "updating numeraire tabulation");
         modelOutputs_.dirty_ = true;
 
+        // the tabulation for a calibration point only depends on its own
+        // inputs and on the tabulation for the later points, so if
+        // requested we skip the latest points as long as nothing changed
+
+        bool incremental = (modelSettings_.adjustments_ &
+                            ModelSettings::IncrementalNumeraireUpdate) != 0;
+
+        std::vector<Real> modelInputs(times_.begin(), times_.end());
+        modelInputs.push_back(
+            termStructure()->discount(numeraireTime_, true));
+        modelInputs.push_back(reversion_(0.0));
+        for (Size i = 0; i < sigma_.size(); ++i)
+            modelInputs.push_back(sigma_.params()[i]);
+
+        bool retabulate = !incremental ||
+                          tabulationInputs_.size() != times_.size() ||
+                          modelInputs != tabulationModelInputs_;
+        tabulationModelInputs_ = modelInputs;
+        if (tabulationInputs_.size() != times_.size())
+            tabulationInputs_ =
+                std::vector<std::vector<Real> >(times_.size());
+
+        std::vector<Real> adjustmentFactors =
+            modelOutputs_.adjustmentFactors_;
+        std::vector<Real> digitalsAdjustmentFactors =
+            modelOutputs_.digitalsAdjustmentFactors_;
         modelOutputs_.adjustmentFactors_.clear();
         modelOutputs_.digitalsAdjustmentFactors_.clear();
 
@@ -475,6 +523,23 @@ namespace QuantLib {
                  i = calibrationPoints_.rbegin();
              i != calibrationPoints_.rend(); ++i, --idx) {
 
+            if (incremental) {
+                std::vector<Real> inputs = tabulationInputs(i->second, idx);
+                if (inputs != tabulationInputs_[idx]) {
+                    retabulate = true;
+                    tabulationInputs_[idx].swap(inputs);
+                }
+                if (!retabulate) {
+                    modelOutputs_.adjustmentFactors_.insert(
+                        modelOutputs_.adjustmentFactors_.begin(),
+                        adjustmentFactors[idx - 1]);
+                    modelOutputs_.digitalsAdjustmentFactors_.insert(
+                        modelOutputs_.digitalsAdjustmentFactors_.begin(),
+                        digitalsAdjustmentFactors[idx - 1]);
+                    continue;
+                }
+            }
+
             ext::shared_ptr<CustomSmileSection> mfSec;
             if (modelSettings_.adjustments_ & ModelSettings::CustomSmile) {
                 mfSec = ext::dynamic_pointer_cast<CustomSmileSection>(
@@ -505,6 +570,54 @@ namespace QuantLib {
                 0.0, CubicInterpolation::Lagrange, 0.0);
             deflatedAnnuities.enableExtrapolation();
 
+            // the integrals of the deflated annuities over the grid
+            // intervals do not depend on the digitals correction below,
+            // so we compute them once for all states
+            Array integrals(y_.size(), 0.0);
+            for (int j = y_.size() - 1; j >= 0; j--) {
+
+                Real integral = 0.0;
+
+                if (j == (int)(y_.size() - 1)) {
+                    if ((modelSettings_.adjustments_ &
+                         ModelSettings::NoPayoffExtrapolation) == 0) {
+                        if ((modelSettings_.adjustments_ &
+                             ModelSettings::ExtrapolatePayoffFlat) != 0) {
+                            integral = gaussianShiftedPolynomialIntegral(
+                                0.0, 0.0, 0.0, 0.0,
+                                discreteDeflatedAnnuities[j - 1], y_[j - 1],
+                                y_[j], 100.0);
+                        } else {
+                            Real ca = deflatedAnnuities.aCoefficients()[j - 1];
+                            Real cb = deflatedAnnuities.bCoefficients()[j - 1];
+                            Real cc = deflatedAnnuities.cCoefficients()[j - 1];
+                            integral = gaussianShiftedPolynomialIntegral(
+                                0.0, cc, cb, ca,
+                                discreteDeflatedAnnuities[j - 1], y_[j - 1],
+                                y_[j], 100.0);
+                        }
+                    }
+                } else {
+                    Real ca = deflatedAnnuities.aCoefficients()[j];
+                    Real cb = deflatedAnnuities.bCoefficients()[j];
+                    Real cc = deflatedAnnuities.cCoefficients()[j];
+                    integral = gaussianShiftedPolynomialIntegral(
+                        0.0, cc, cb, ca, discreteDeflatedAnnuities[j], y_[j],
+                        y_[j], y_[j + 1]);
+                }
+
+                if (integral < 0) {
+                    QL_MFMESSAGE(modelOutputs_,
+                                 "WARNING: integral for digitalPrice is "
+                                 "negative for j="
+                                     << j << " (" << integral
+                                     << ") --- reset it to zero.");
+                    integral = 0.0;
+                }
+
+                integrals[j] = integral;
+            }
+
             Real digitalsCorrectionFactor = 1.0;
             modelOutputs_.digitalsAdjustmentFactors_.insert(
                 modelOutputs_.digitalsAdjustmentFactors_.begin(),
@@ -528,49 +641,8 @@ namespace QuantLib {
                     modelSettings_.upperRateBound_ / 2.0; // initial guess
                 for (int j = y_.size() - 1; j >= 0; j--) {
 
-                    Real integral = 0.0;
-
-                    if (j == (int)(y_.size() - 1)) {
-                        if ((modelSettings_.adjustments_ &
-                             ModelSettings::NoPayoffExtrapolation) == 0) {
-                            if ((modelSettings_.adjustments_ &
-                                 ModelSettings::ExtrapolatePayoffFlat) != 0) {
-                                integral = gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0,
-                                    discreteDeflatedAnnuities[j - 1], y_[j - 1],
-                                    y_[j], 100.0);
-                            } else {
-                                Real ca =
-                                    deflatedAnnuities.aCoefficients()[j - 1];
-                                Real cb =
-                                    deflatedAnnuities.bCoefficients()[j - 1];
-                                Real cc =
-                                    deflatedAnnuities.cCoefficients()[j - 1];
-                                integral = gaussianShiftedPolynomialIntegral(
-                                    0.0, cc, cb, ca,
-                                    discreteDeflatedAnnuities[j - 1], y_[j - 1],
-                                    y_[j], 100.0);
-                            }
-                        }
-                    } else {
-                        Real ca = deflatedAnnuities.aCoefficients()[j];
-                        Real cb = deflatedAnnuities.bCoefficients()[j];
-                        Real cc = deflatedAnnuities.cCoefficients()[j];
-                        integral = gaussianShiftedPolynomialIntegral(
-                            0.0, cc, cb, ca, discreteDeflatedAnnuities[j],
-                            y_[j], y_[j], y_[j + 1]);
-                    }
-
-                    if (integral < 0) {
-                        QL_MFMESSAGE(modelOutputs_,
-                                     "WARNING: integral for digitalPrice is "
-                                     "negative for j="
-                                         << j << " (" << integral
-                                         << ") --- reset it to zero.");
-                        integral = 0.0;
-                    }
-
-                    digital += integral * numeraire0 * digitalsCorrectionFactor;
+                    digital +=
+                        integrals[j] * numeraire0 * digitalsCorrectionFactor;
 
                     bool check = true;
                     if (modelSettings_.adjustments_ &
@@ -794,15 +866,21 @@ namespace QuantLib {
         Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
         Real stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
 
+        // the numeraire at T is evaluated for all states and integration
+        // points in one go
+        const Size n = modelSettings_.gaussHermitePoints_;
+        Array ya(y.size() * n);
         for (Size j = 0; j < y.size(); j++) {
-            Array ya(modelSettings_.gaussHermitePoints_);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                ya[i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
-                        stdDev_0_T;
+            for (Size i = 0; i < n; i++) {
+                ya[j * n + i] =
+                    (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
+                    stdDev_0_T;
             }
-            Array res = numeraireArray(T, ya);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                result[j] += normalIntegralW_[i] / res[i];
+        }
+        Array res = numeraireArray(T, ya);
+        for (Size j = 0; j < y.size(); j++) {
+            for (Size i = 0; i < n; i++) {
+                result[j] += normalIntegralW_[i] / res[j * n + i];
             }
         }
 
@@ -93,6 +93,16 @@ namespace QuantLib {
       digital prices to market rates, so digitalGap, marketRateAccuracy,
       lowerRateBound, upperRateBound are irrelavant and the smile moneyness
       checkpoints are only used for the debug model output in this setup.
+
+      If IncrementalNumeraireUpdate is specified, a recalculation of the model
+      only retabulates the numeraire for the calibration points up to the
+      latest one whose inputs have changed. Since the tabulation is done
+      backward in time, later points are not affected. The inputs of a point
+      are its atm level, annuity and discount factors, the model volatilities
+      and the raw smile's option prices on the smile moneyness checkpoints.
+      This is exact when the Kahale or SABR smile pretreatment is used, since
+      these only see the raw smile on the checkpoints. Without pretreatment a
+      change of the smile between the checkpoints is not detected.
     */
 
     class MarkovFunctional : public Gaussian1dModel, public CalibratedModel {
@@ -128,7 +138,8 @@ namespace QuantLib {
                 KahaleInterpolation = 1 << 6,
                 SmileDeleteArbitragePoints = 1 << 7,
                 SabrSmile = 1 << 8,
-                CustomSmile = 1 << 9
+                CustomSmile = 1 << 9,
+                IncrementalNumeraireUpdate = 1 << 10
             };
 
             ModelSettings()
@@ -362,6 +373,7 @@ namespace QuantLib {
         // if an empty vector is given, the dynamic calculation is used again
         void forceArbitrageIndices(const std::vector<std::pair<Size,Size> >& indices) {
             forcedArbitrageIndices_ = indices;
+            tabulationInputs_.clear();
             this->update();
         }
 
@@ -379,6 +391,7 @@ namespace QuantLib {
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            flushGridCache();
             notifyObservers();
         }
 
@@ -409,6 +422,9 @@ namespace QuantLib {
                                           const Period &tenor);
         void makeCapletCalibrationPoint(const Date &expiry);
 
+        const Disposable<std::vector<Real> >
+        tabulationInputs(const CalibrationPoint &p, const Size idx) const;
+
         Real marketSwapRate(const Date &expiry, const CalibrationPoint &p,
                             const Real digitalPrice,
                             const Real guess = 0.03,
@@ -527,6 +543,11 @@ namespace QuantLib {
 
         mutable std::vector<std::pair<Size,Size> > arbitrageIndices_;
         std::vector<std::pair<Size,Size> > forcedArbitrageIndices_;
+
+        // inputs of the last numeraire tabulation, per calibration time
+        // and for the model as a whole
+        mutable std::vector<std::vector<Real> > tabulationInputs_;
+        mutable std::vector<Real> tabulationModelInputs_;
     };
 
     std::ostream &operator<<(std::ostream &out,
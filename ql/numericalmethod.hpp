@@ -27,6 +27,7 @@
 
 #include <ql/timegrid.hpp>
 #include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -63,6 +64,17 @@ namespace QuantLib {
         virtual void rollback(DiscretizedAsset&,
                               Time to) const = 0;
 
+        /*! Roll back a set of assets, all at the same time, until
+            the given time, performing any needed adjustment.  The
+            default implementation rolls them back one at a time;
+            derived classes can override it to share work among them.
+        */
+        virtual void rollback(const std::vector<DiscretizedAsset*>& assets,
+                              Time to) const {
+            for (Size i=0; i<assets.size(); ++i)
+                rollback(*assets[i], to);
+        }
+
         /*! Roll back an asset until the given time, but do not perform
             the final adjustment.
 
@@ -199,9 +199,90 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
-
-            for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
+            // the conditional forward rates, zerobonds (including the oas
+            // discount factors) and numeraires on the integration grid are
+            // retrieved from the model's cache before entering the loop
+            // below. Since a lazy object is not thread safe, neither is the
+            // caching in gsrprocess or in the model, this also ensures that
+            // neither lazy object recalculation nor write access during
+            // caching occurs in the parallized loop below.
+            std::vector<Array> floatingRates, floatingZerobonds,
+                fixedZerobonds;
+            Array rebateZerobonds, numeraires;
+            Real rebate = 0.0;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(
+                                                expiry0,
+                                                arguments_
+                                                    .floatingPayDates[l])));
+                    if (arguments_.floatingIsRedemptionFlow[l])
+                        floatingRates.push_back(Array());
+                    else
+                        floatingRates.push_back(model_->forwardRateGrid(
+                            arguments_.floatingFixingDates[l], expiry0,
+                            stddevs_, integrationPoints_,
+                            arguments_.swap->iborIndex()));
+                    floatingZerobonds.push_back(
+                        model_->zerobondGrid(arguments_.floatingPayDates[l],
+                                             expiry0, stddevs_,
+                                             integrationPoints_,
+                                             discountCurve_) *
+                        zSpreadDf);
+                }
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(
+                                                expiry0,
+                                                arguments_.fixedPayDates[l])));
+                    fixedZerobonds.push_back(
+                        model_->zerobondGrid(arguments_.fixedPayDates[l],
+                                             expiry0, stddevs_,
+                                             integrationPoints_,
+                                             discountCurve_) *
+                        zSpreadDf);
+                }
+                Real zSpreadDf = 1.0;
+                Date rebateDate = expiry0;
+                if (rebatedExercise != NULL) {
+                    rebate = rebatedExercise->rebate(idx);
+                    rebateDate = rebatedExercise->rebatePaymentDate(idx);
+                    zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(expiry0, rebateDate)));
+                }
+                rebateZerobonds =
+                    model_->zerobondGrid(rebateDate, expiry0, stddevs_,
+                                         integrationPoints_, discountCurve_) *
+                    zSpreadDf;
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+            }
+#ifdef _OPENMP
+            if (expiry1Time != Null<Real>())
+                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                              expiry0Time, 0.0);
+            if (!oas_.empty())
+                oas_->value();
+#endif
+
+#pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
+            for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
                  k++) {
 
                 Real price = 0.0;
@@ -364,17 +445,6 @@ namespace QuantLib {
                     Real floatingLegNpv = 0.0;
                     for (Size l = k1; l < arguments_.floatingCoupons.size();
                          l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_
-                                                    .floatingPayDates[l])));
                         Real amount;
                         if (arguments_.floatingIsRedemptionFlow[l])
                             amount = arguments_.floatingCoupons[l];
@@ -382,57 +452,22 @@ namespace QuantLib {
                             amount = arguments_.floatingNominal[l] *
                                      arguments_.floatingAccrualTimes[l] *
                                      (arguments_.floatingGearings[l] *
-                                          model_->forwardRate(
-                                              arguments_.floatingFixingDates[l],
-                                              expiry0, z[k],
-                                              arguments_.swap->iborIndex()) +
+                                          floatingRates[l - k1][k] +
                                       arguments_.floatingSpreads[l]);
                         floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            amount * floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_.fixedPayDates[l])));
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real rebate = 0.0;
-                    Real zSpreadDf = 1.0;
-                    Date rebateDate = expiry0;
-                    if (rebatedExercise != NULL) {
-                        rebate = rebatedExercise->rebate(idx);
-                        rebateDate = rebatedExercise->rebatePaymentDate(idx);
-                        zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(expiry0, rebateDate)));
+                            fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         ((type == Option::Call ? 1.0 : -1.0) *
                              (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                         rebate * rebateZerobonds[k]) /
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
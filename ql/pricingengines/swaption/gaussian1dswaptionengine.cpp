@@ -89,30 +89,38 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
-            // a lazy object is not thread safe, neither is the caching
-            // in gsrprocess. therefore we trigger computations here such
-            // that neither lazy object recalculation nor write access
-            // during caching occurs in the parallized loop below.
-            // this is known to work for the gsr and markov functional
-            // model implementations of Gaussian1dModel
-#ifdef _OPENMP
-            if (expiry1Time != Null<Real>())
-                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
-                              expiry0Time, 0.0);
+            // the conditional forward rates, zerobonds and numeraires on
+            // the integration grid are retrieved from the model's cache
+            // before entering the loop below. Since a lazy object is not
+            // thread safe, neither is the caching in gsrprocess or in the
+            // model, this also ensures that neither lazy object
+            // recalculation nor write access during caching occurs in the
+            // parallized loop below. this is known to work for the gsr and
+            // markov functional model implementations of Gaussian1dModel
+            std::vector<Array> floatingRates, floatingZerobonds,
+                fixedZerobonds;
+            Array numeraires;
             if (expiry0 > settlement) {
                 for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
-                    model_->forwardRate(arguments_.floatingFixingDates[l],
-                                        expiry0, 0.0,
-                                        arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
+                    floatingRates.push_back(model_->forwardRateGrid(
+                        arguments_.floatingFixingDates[l], expiry0, stddevs_,
+                        integrationPoints_, arguments_.swap->iborIndex()));
+                    floatingZerobonds.push_back(model_->zerobondGrid(
+                        arguments_.floatingPayDates[l], expiry0, stddevs_,
+                        integrationPoints_, discountCurve_));
                 }
                 for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
+                    fixedZerobonds.push_back(model_->zerobondGrid(
+                        arguments_.fixedPayDates[l], expiry0, stddevs_,
+                        integrationPoints_, discountCurve_));
                 }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
             }
+#ifdef _OPENMP
+            if (expiry1Time != Null<Real>())
+                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                              expiry0Time, 0.0);
 #endif
 
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
@@ -261,23 +269,18 @@ namespace QuantLib {
                             arguments_.nominal *
                             arguments_.floatingAccrualTimes[l] *
                             (arguments_.floatingSpreads[l] +
-                             model_->forwardRate(
-                                 arguments_.floatingFixingDates[l], expiry0,
-                                 z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                             floatingRates[l - k1][k]) *
+                            floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        (floatingLegNpv - fixedLegNpv) / numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
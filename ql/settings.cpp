@@ -35,6 +35,12 @@ namespace QuantLib {
     : includeReferenceDateEvents_(false),
       enforcesTodaysHistoricFixings_(false) {}
 
+    #if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+    thread_local Settings* Settings::local_ = 0;
+    #elif !defined(QL_ENABLE_SESSIONS)
+    Settings* Settings::local_ = 0;
+    #endif
+
     void Settings::anchorEvaluationDate() {
         // set to today's date if not already set.
         if (evaluationDate_.value() == Date())
@@ -69,4 +75,23 @@ namespace QuantLib {
         }
     }
 
+    #if !defined(QL_ENABLE_SESSIONS)
+
+    LocalSettings::LocalSettings() : previous_(Settings::local_) {
+        const Settings& current = Settings::instance();
+        settings_.evaluationDate_ = current.evaluationDate_.value();
+        settings_.includeReferenceDateEvents_ =
+            current.includeReferenceDateEvents_;
+        settings_.includeTodaysCashFlows_ = current.includeTodaysCashFlows_;
+        settings_.enforcesTodaysHistoricFixings_ =
+            current.enforcesTodaysHistoricFixings_;
+        Settings::local_ = &settings_;
+    }
+
+    LocalSettings::~LocalSettings() {
+        Settings::local_ = previous_;
+    }
+
+    #endif
+
 }
@@ -34,8 +34,17 @@
 namespace QuantLib {
 
     //! global repository for run-time library settings
+    /*! Unless sessions are enabled, the settings can be temporarily
+        replaced by creating a LocalSettings instance; when the
+        library is compiled with QL_ENABLE_THREAD_LOCAL_SETTINGS
+        defined, this only affects the thread creating it.  See the
+        documentation of LocalSettings.
+    */
     class Settings : public Singleton<Settings> {
         friend class Singleton<Settings>;
+        #if !defined(QL_ENABLE_SESSIONS)
+        friend class LocalSettings;
+        #endif
       private:
         Settings();
         class DateProxy : public ObservableValue<Date> {
@@ -46,6 +55,13 @@ namespace QuantLib {
         };
         friend std::ostream& operator<<(std::ostream&, const DateProxy&);
       public:
+        #if !defined(QL_ENABLE_SESSIONS)
+        //! access to the settings in use
+        /*! If thread-local settings are enabled, these are the
+            settings in use in the current thread.
+        */
+        static Settings& instance();
+        #endif
         //! the date at which pricing is to be performed.
         /*! Client code can inspect the evaluation date, as in:
             \code
@@ -112,6 +128,11 @@ namespace QuantLib {
         bool includeReferenceDateEvents_;
         boost::optional<bool> includeTodaysCashFlows_;
         bool enforcesTodaysHistoricFixings_;
+        #if defined(QL_ENABLE_THREAD_LOCAL_SETTINGS)
+        static thread_local Settings* local_;
+        #elif !defined(QL_ENABLE_SESSIONS)
+        static Settings* local_;
+        #endif
     };
 
 
@@ -128,8 +149,60 @@ namespace QuantLib {
     };
 
 
+    #if !defined(QL_ENABLE_SESSIONS)
+
+    //! local settings
+    /*! While an instance of this class is alive, Settings::instance()
+        returns a private copy of the settings previously in use.  The
+        previous settings are restored on destruction, so instances
+        can be nested.
+
+        When the library is compiled with
+        QL_ENABLE_THREAD_LOCAL_SETTINGS defined, the copy is only used
+        in the thread that created the instance; other threads are not
+        affected.  This allows different threads to perform
+        calculations, e.g., at different evaluation dates at the same
+        time.  Otherwise, the copy replaces the settings for the whole
+        program, and instances shouldn't be used by concurrent
+        threads.
+
+        \warning objects with a floating reference date register
+                 with the evaluation date of the thread in which they
+                 are created and are not notified of changes in other
+                 threads.  They shouldn't be shared between threads
+                 using different settings; each thread should build
+                 its own term structures and instruments.
+
+        \warning fixings are not part of the settings.  The fixing
+                 histories stored by the IndexManager are shared by
+                 all threads; indexes can be created and destroyed in
+                 any thread, since their registration with the
+                 histories is synchronized, but fixings shouldn't be
+                 added or cleared while other threads are running.
+
+        \warning instances must be destroyed in the same thread
+                 that created them, in reverse order of creation.
+    */
+    class LocalSettings : private boost::noncopyable {
+      public:
+        LocalSettings();
+        ~LocalSettings();
+      private:
+        Settings settings_;
+        Settings* previous_;
+    };
+
+    #endif
+
+
     // inline
 
+    #if !defined(QL_ENABLE_SESSIONS)
+    inline Settings& Settings::instance() {
+        return local_ != 0 ? *local_ : Singleton<Settings>::instance();
+    }
+    #endif
+
     inline Settings::DateProxy::operator Date() const {
         if (value() == Date())
             return Date::todaysDate();
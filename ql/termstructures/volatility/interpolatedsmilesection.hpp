@@ -85,6 +85,14 @@ namespace QuantLib {
         Real maxStrike () const { return strikes_.back(); }
         virtual Real atmLevel() const { return atmLevel_->value(); }
         void update();
+        //! returns an immutable copy of the smile section
+        /*! The copy has the current volatilities and ATM level and,
+            for sections defined by an exercise date, a fixed
+            reference date.  It is already calculated and frozen and
+            doesn't observe any other object; therefore, it can be
+            read concurrently from several threads.
+        */
+        ext::shared_ptr<SmileSection> snapshot() const;
       private:
         Real exerciseTimeSquareRoot_;
         std::vector<Rate> strikes_;
@@ -92,6 +100,7 @@ namespace QuantLib {
         Handle<Quote> atmLevel_;
         mutable std::vector<Volatility> vols_;
         mutable Interpolation interpolation_;
+        Interpolator interpolator_;
     };
 
 
@@ -108,7 +117,8 @@ namespace QuantLib {
     : SmileSection(timeToExpiry, dc, type, shift),
       exerciseTimeSquareRoot_(std::sqrt(exerciseTime())), strikes_(strikes),
       stdDevHandles_(stdDevHandles), atmLevel_(atmLevel),
-      vols_(stdDevHandles.size())
+      vols_(stdDevHandles.size()),
+      interpolator_(interpolator)
     {
         for (Size i=0; i<stdDevHandles_.size(); ++i)
             LazyObject::registerWith(stdDevHandles_[i]);
@@ -131,7 +141,8 @@ namespace QuantLib {
                                 const Real shift)
     : SmileSection(timeToExpiry, dc, type, shift),
       exerciseTimeSquareRoot_(std::sqrt(exerciseTime())), strikes_(strikes),
-      stdDevHandles_(stdDevs.size()), vols_(stdDevs.size())
+      stdDevHandles_(stdDevs.size()), vols_(stdDevs.size()),
+      interpolator_(interpolator)
     {
         // fill dummy handles to allow generic handle-based
         // computations later on
@@ -159,7 +170,8 @@ namespace QuantLib {
                            const Real shift)
     : SmileSection(d, dc, referenceDate, type, shift),
       exerciseTimeSquareRoot_(std::sqrt(exerciseTime())), strikes_(strikes),
-      stdDevHandles_(stdDevHandles), atmLevel_(atmLevel), vols_(stdDevHandles.size())
+      stdDevHandles_(stdDevHandles), atmLevel_(atmLevel), vols_(stdDevHandles.size()),
+      interpolator_(interpolator)
     {
         for (Size i=0; i<stdDevHandles_.size(); ++i)
             LazyObject::registerWith(stdDevHandles_[i]);
@@ -183,7 +195,8 @@ namespace QuantLib {
                            const Real shift)
     : SmileSection(d, dc, referenceDate, type, shift),
       exerciseTimeSquareRoot_(std::sqrt(exerciseTime())), strikes_(strikes),
-      stdDevHandles_(stdDevs.size()), vols_(stdDevs.size())
+      stdDevHandles_(stdDevs.size()), vols_(stdDevs.size()),
+      interpolator_(interpolator)
     {
         //fill dummy handles to allow generic handle-based
         // computations later on
@@ -228,6 +241,34 @@ namespace QuantLib {
     }
     #endif
 
+    template <class Interpolator>
+    ext::shared_ptr<SmileSection>
+    InterpolatedSmileSection<Interpolator>::snapshot() const {
+        calculate();
+        // the copy will recover the current volatilities
+        std::vector<Real> stdDevs(vols_.size());
+        Real sqrtT = std::sqrt(exerciseTime());
+        for (Size i=0; i<vols_.size(); ++i)
+            stdDevs[i] = vols_[i]*sqrtT;
+        Real atm = atmLevel_.empty() ? Null<Real>() : atmLevel_->value();
+
+        ext::shared_ptr<InterpolatedSmileSection<Interpolator> > copy;
+        if (exerciseDate() != Date())
+            copy = ext::shared_ptr<InterpolatedSmileSection<Interpolator> >(
+                new InterpolatedSmileSection<Interpolator>(
+                    exerciseDate(), strikes_, stdDevs, atm, dayCounter(),
+                    interpolator_, referenceDate(), volatilityType(),
+                    shift()));
+        else
+            copy = ext::shared_ptr<InterpolatedSmileSection<Interpolator> >(
+                new InterpolatedSmileSection<Interpolator>(
+                    exerciseTime(), strikes_, stdDevs, atm, interpolator_,
+                    dayCounter(), volatilityType(), shift()));
+        copy->calculate();
+        copy->freeze();
+        return copy;
+    }
+
 }
 
 #endif
@@ -46,7 +46,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionT, swapT, 0, cal, bdc, dc),
       volHandles_(vols), shiftValues_(shifts),
       volatilities_(vols.size(), vols.front().size()),
-      shifts_(vols.size(), vols.front().size(), 0.0), volatilityType_(type) {
+      shifts_(vols.size(), vols.front().size(), 0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
         checkInputs(volatilities_.rows(), volatilities_.columns(),
                     shifts.size(), shifts.size() == 0 ? 0 : shifts.front().size());
         registerWithMarketData();
@@ -84,7 +85,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionT, swapT, refDate, cal, bdc, dc),
       volHandles_(vols), shiftValues_(shifts),
       volatilities_(vols.size(), vols.front().size()),
-      shifts_(vols.size(), vols.front().size(), 0.0), volatilityType_(type) {
+      shifts_(vols.size(), vols.front().size(), 0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
         checkInputs(volatilities_.rows(), volatilities_.columns(),
                     shifts.size(), shifts.size() == 0 ? 0 : shifts.front().size());
         registerWithMarketData();
@@ -121,7 +123,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionT, swapT, 0, cal, bdc, dc),
       volHandles_(vols.rows()), shiftValues_(vols.rows()),
       volatilities_(vols.rows(), vols.columns()),
-      shifts_(vols.rows(), vols.columns(), 0.0), volatilityType_(type) {
+      shifts_(vols.rows(), vols.columns(), 0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
 
         checkInputs(vols.rows(), vols.columns(), shifts.rows(), shifts.columns());
 
@@ -170,7 +173,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionT, swapT, refDate, cal, bdc, dc),
       volHandles_(vols.rows()), shiftValues_(vols.rows()),
       volatilities_(vols.rows(), vols.columns()),
-      shifts_(shifts.rows(), shifts.columns(), 0.0), volatilityType_(type) {
+      shifts_(shifts.rows(), shifts.columns(), 0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
 
         checkInputs(vols.rows(), vols.columns(), shifts.rows(), shifts.columns());
 
@@ -219,7 +223,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionDates, swapT, today, calendar, bdc, dc),
       volHandles_(vols.rows()), shiftValues_(vols.rows()),
       volatilities_(vols.rows(), vols.columns()),
-      shifts_(shifts.rows(),shifts.columns(),0.0), volatilityType_(type) {
+      shifts_(shifts.rows(),shifts.columns(),0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
 
         checkInputs(vols.rows(), vols.columns(), shifts.rows(), shifts.columns());
 
@@ -266,7 +271,8 @@ namespace QuantLib {
     : SwaptionVolatilityDiscrete(optionDates, swapT, today, Calendar(), Following, dc),
       volHandles_(vols.rows()), shiftValues_(vols.rows()),
       volatilities_(vols.rows(), vols.columns()),
-      shifts_(shifts.rows(),shifts.columns(),0.0), volatilityType_(type) {
+      shifts_(shifts.rows(),shifts.columns(),0.0), volatilityType_(type),
+      flatExtrapolation_(flatExtrapolation) {
 
         checkInputs(vols.rows(), vols.columns(), shifts.rows(), shifts.columns());
 
@@ -352,6 +358,23 @@ namespace QuantLib {
         }
     }
 
+    ext::shared_ptr<SwaptionVolatilityStructure>
+    SwaptionVolatilityMatrix::snapshot() const {
+        calculate();
+        ext::shared_ptr<SwaptionVolatilityMatrix> copy(
+            new SwaptionVolatilityMatrix(referenceDate(), calendar(),
+                                         businessDayConvention(),
+                                         optionDates(), swapTenors(),
+                                         volatilities_, dayCounter(),
+                                         flatExtrapolation_, volatilityType_,
+                                         shifts_));
+        if (allowsExtrapolation())
+            copy->enableExtrapolation();
+        copy->calculate();
+        copy->freeze();
+        return copy;
+    }
+
     //ext::shared_ptr<SmileSection>
     //SwaptionVolatilityMatrix::smileSectionImpl(const Date& d,
     //                                           const Period& swapTenor) const {
@@ -158,6 +158,13 @@ namespace QuantLib {
         }
         //@}
         VolatilityType volatilityType() const;
+        //! returns an immutable copy of the volatility matrix
+        /*! The copy has the current volatilities, option dates and
+            reference date.  It is already calculated and frozen and
+            doesn't observe any other object; therefore, it can be
+            read concurrently from several threads.
+        */
+        ext::shared_ptr<SwaptionVolatilityStructure> snapshot() const;
       protected:
         // defining the following method would break CMS test suite
         // to be further investigated
@@ -180,6 +187,7 @@ namespace QuantLib {
         mutable Matrix volatilities_, shifts_;
         Interpolation2D interpolation_, interpolationShifts_;
         VolatilityType volatilityType_;
+        bool flatExtrapolation_;
     };
 
     // inline definitions
@@ -95,6 +95,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* d, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +169,20 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(const Time* t,
+                                                     DiscountFactor* d,
+                                                     Size n) const {
+        this->interpolation_(t, d, n, true);
+
+        // flat fwd extrapolation
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] > tMax)
+                d[i] = discountImpl(t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -30,6 +30,7 @@
 #include <ql/termstructures/localbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 namespace QuantLib {
 
@@ -169,6 +170,30 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! returns an immutable copy of the bootstrapped curve
+        /*! The copy is an interpolated curve with the same nodes,
+            interpolation and jump dates, whose reference date and
+            jump values are fixed at their current values.  It
+            doesn't observe any other object and doesn't perform any
+            lazy calculation; therefore, it can be read concurrently
+            from several threads.  It is not affected by later changes
+            of market quotes or evaluation date.
+        */
+        ext::shared_ptr<YieldTermStructure> snapshot() const;
+        //! sets the value of the curve at the i-th node
+        /*! The curve is bootstrapped first if needed; the given
+            value then replaces the bootstrapped one as the traits
+            would do during the bootstrap, and observers are
+            notified.  The value is kept until the curve is
+            bootstrapped again, e.g., because of a change in the
+            quotes or evaluation date; freezing the curve prevents
+            this.  This allows one to calculate sensitivities to the
+            curve nodes.
+
+            \pre i > 0, since the value at the reference date is
+                 set by the traits.
+        */
+        void setNodeValue(Size i, Real value);
         //! \name Observer interface
         //@{
         void update();
@@ -180,6 +205,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, DiscountFactor* d, Size n) const;
         // data members
         std::vector<ext::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -229,6 +255,35 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    ext::shared_ptr<YieldTermStructure>
+    PiecewiseYieldCurve<C,I,B>::snapshot() const {
+        calculate();
+        const std::vector<Handle<Quote> >& jumps = this->jumps();
+        std::vector<Handle<Quote> > fixedJumps(jumps.size());
+        for (Size i=0; i<jumps.size(); ++i)
+            fixedJumps[i] = Handle<Quote>(
+                ext::make_shared<SimpleQuote>(jumps[i]->value()));
+        ext::shared_ptr<YieldTermStructure> copy(
+            new base_curve(this->dates_, this->data_, this->dayCounter(),
+                           this->calendar(), fixedJumps, this->jumpDates(),
+                           this->interpolator_));
+        if (this->allowsExtrapolation())
+            copy->enableExtrapolation();
+        return copy;
+    }
+
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::setNodeValue(Size i, Real value) {
+        calculate();
+        QL_REQUIRE(i > 0 && i < this->data_.size(),
+                   "node index (" << i << ") out of range [1, "
+                   << this->data_.size() << ")");
+        C::updateGuess(this->data_, value, i);
+        this->interpolation_.update();
+        notifyObservers();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -250,6 +305,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    void PiecewiseYieldCurve<C,I,B>::discountsImpl(const Time* t,
+                                                   DiscountFactor* d,
+                                                   Size n) const {
+        calculate();
+        base_curve::discountsImpl(t, d, n);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
@@ -103,6 +103,7 @@ namespace QuantLib {
         //! \name ZeroYieldStructure implementation
         //@{
         Rate zeroYieldImpl(Time t) const;
+        void discountsImpl(const Time* t, DiscountFactor* d, Size n) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -170,6 +171,23 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(const Time* t,
+                                                 DiscountFactor* d,
+                                                 Size n) const {
+        this->interpolation_(t, d, n, true);
+
+        Time tMax = this->times_.back();
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0)
+                d[i] = 1.0;
+            else if (t[i] > tMax)
+                d[i] = discountImpl(t[i]);
+            else
+                d[i] = DiscountFactor(std::exp(-d[i]*t[i]));
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
@@ -108,6 +108,46 @@ namespace QuantLib {
         return jumpEffect * discountImpl(t);
     }
 
+    std::vector<DiscountFactor>
+    YieldTermStructure::discount(const std::vector<Time>& t,
+                                 bool extrapolate) const {
+        std::vector<DiscountFactor> result(t.size());
+        if (t.empty())
+            return result;
+
+        Time tMin = t[0], tMax = t[0];
+        for (Size i=1; i<t.size(); ++i) {
+            tMin = std::min(tMin, t[i]);
+            tMax = std::max(tMax, t[i]);
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        discountsImpl(&t[0], &result[0], t.size());
+
+        for (Size i=0; i<nJumps_; ++i) {
+            if (jumpTimes_[i]>0 && jumpTimes_[i]<tMax) {
+                QL_REQUIRE(jumps_[i]->isValid(),
+                           "invalid " << io::ordinal(i+1) << " jump quote");
+                DiscountFactor thisJump = jumps_[i]->value();
+                QL_REQUIRE(thisJump > 0.0,
+                           "invalid " << io::ordinal(i+1) << " jump value: " <<
+                           thisJump);
+                for (Size j=0; j<t.size(); ++j) {
+                    if (jumpTimes_[i]<t[j])
+                        result[j] *= thisJump;
+                }
+            }
+        }
+        return result;
+    }
+
+    void YieldTermStructure::discountsImpl(const Time* t, DiscountFactor* d,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            d[i] = discountImpl(t[i]);
+    }
+
     InterestRate YieldTermStructure::zeroRate(const Date& d,
                                               const DayCounter& dayCounter,
                                               Compounding comp,
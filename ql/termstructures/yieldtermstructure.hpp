@@ -77,6 +77,14 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Returns the discount factors at the given times.  This
+            is faster than repeated calls to the single-time version
+            for curves that can evaluate a set of times at once, such
+            as interpolated curves, especially when the times are
+            sorted.
+        */
+        std::vector<DiscountFactor> discount(const std::vector<Time>& t,
+                                             bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -148,6 +156,7 @@ namespace QuantLib {
 
         //! \name Jump inspectors
         //@{
+        const std::vector<Handle<Quote> >& jumps() const;
         const std::vector<Date>& jumpDates() const;
         const std::vector<Time>& jumpTimes() const;
         //@}
@@ -167,6 +176,12 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factor calculation for a set of times; the
+            default implementation calls discountImpl(Time) for each
+            of them.
+        */
+        virtual void discountsImpl(const Time* t, DiscountFactor* d,
+                                   Size n) const;
         //@}
       private:
         // methods
@@ -197,6 +212,11 @@ namespace QuantLib {
         return forwardRate(d, d+p, dayCounter, comp, freq, extrapolate);
     }
 
+    inline const std::vector<Handle<Quote> >&
+    YieldTermStructure::jumps() const {
+        return this->jumps_;
+    }
+
     inline const std::vector<Date>& YieldTermStructure::jumpDates() const {
         return this->jumpDates_;
     }
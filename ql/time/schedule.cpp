@@ -22,6 +22,7 @@
 #include <ql/time/schedule.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/settings.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -207,7 +208,7 @@ namespace QuantLib {
         // calendar needed for endOfMonth adjustment
         Calendar nullCalendar = NullCalendar();
         Integer periods = 1;
-        Date seed, exitDate;
+        Date seed, exitDate, lastAdjusted;
         switch (*rule_) {
 
           case DateGeneration::Zero:
@@ -219,17 +220,20 @@ namespace QuantLib {
 
           case DateGeneration::Backward:
 
+            // dates are appended going backwards and reversed at the
+            // end, so that the vectors don't need to be shifted at
+            // each insertion
             dates_.push_back(terminationDate);
 
             seed = terminationDate;
             if (nextToLastDate_ != Date()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
+                dates_.push_back(nextToLastDate_);
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
+                    isRegular_.push_back(false);
                 else
-                    isRegular_.insert(isRegular_.begin(), true);
+                    isRegular_.push_back(true);
                 seed = nextToLastDate_;
             }
 
@@ -237,34 +241,41 @@ namespace QuantLib {
             if (firstDate_ != Date())
                 exitDate = firstDate_;
 
+            // adjusted value of the earliest date generated so far
+            lastAdjusted = calendar_.adjust(dates_.back(),convention);
             for (;;) {
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp < exitDate) {
                     if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.front(),convention)!=
+                        (lastAdjusted!=
                          calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
+                        dates_.push_back(firstDate_);
+                        isRegular_.push_back(false);
+                        lastAdjusted =
+                            calendar_.adjust(firstDate_,convention);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.front(),convention)!=
-                        calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                    Date adjusted = calendar_.adjust(temp,convention);
+                    if (lastAdjusted!=adjusted) {
+                        dates_.push_back(temp);
+                        isRegular_.push_back(true);
+                        lastAdjusted = adjusted;
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.front(),convention)!=
-                calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
+            if (lastAdjusted!=calendar_.adjust(effectiveDate,convention)) {
+                dates_.push_back(effectiveDate);
+                isRegular_.push_back(false);
             }
+
+            std::reverse(dates_.begin(), dates_.end());
+            std::reverse(isRegular_.begin(), isRegular_.end());
             break;
 
           case DateGeneration::Twentieth:
@@ -325,12 +336,14 @@ namespace QuantLib {
                && terminationDate.month() %2 == 1) {
                 exitDate = nextTwentieth(terminationDate+1, *rule_);
             }
+            // adjusted value of the latest date generated so far
+            lastAdjusted = calendar_.adjust(dates_.back(),convention);
             for (;;) {
                 Date temp = nullCalendar.advance(seed, periods*(*tenor_),
                                                  convention, *endOfMonth_);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
+                        (lastAdjusted!=
                          calendar_.adjust(nextToLastDate_,convention))) {
                         dates_.push_back(nextToLastDate_);
                         isRegular_.push_back(false);
@@ -339,10 +352,11 @@ namespace QuantLib {
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
-                        calendar_.adjust(temp,convention)) {
+                    Date adjusted = calendar_.adjust(temp,convention);
+                    if (lastAdjusted!=adjusted) {
                         dates_.push_back(temp);
                         isRegular_.push_back(true);
+                        lastAdjusted = adjusted;
                     }
                     ++periods;
                 }
@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+
+namespace QuantLib {
+
+    bool ScheduleCache::Key::operator<(const Key& k) const {
+        if (effectiveDate != k.effectiveDate)
+            return effectiveDate < k.effectiveDate;
+        if (terminationDate != k.terminationDate)
+            return terminationDate < k.terminationDate;
+        if (tenorLength != k.tenorLength)
+            return tenorLength < k.tenorLength;
+        if (tenorUnits != k.tenorUnits)
+            return tenorUnits < k.tenorUnits;
+        if (convention != k.convention)
+            return convention < k.convention;
+        if (terminationDateConvention != k.terminationDateConvention)
+            return terminationDateConvention < k.terminationDateConvention;
+        if (rule != k.rule)
+            return rule < k.rule;
+        if (endOfMonth != k.endOfMonth)
+            return endOfMonth < k.endOfMonth;
+        if (firstDate != k.firstDate)
+            return firstDate < k.firstDate;
+        if (nextToLastDate != k.nextToLastDate)
+            return nextToLastDate < k.nextToLastDate;
+        // last, since it's the most expensive comparison
+        return calendar < k.calendar;
+    }
+
+    ext::shared_ptr<const Schedule> ScheduleCache::schedule(
+                               const Date& effectiveDate,
+                               const Date& terminationDate,
+                               const Period& tenor,
+                               const Calendar& calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth,
+                               const Date& firstDate,
+                               const Date& nextToLastDate) {
+        if (effectiveDate == Date()) {
+            // depends on the evaluation date; not cached
+            return ext::make_shared<Schedule>(effectiveDate, terminationDate,
+                                              tenor, calendar, convention,
+                                              terminationDateConvention,
+                                              rule, endOfMonth,
+                                              firstDate, nextToLastDate);
+        }
+
+        Key key;
+        key.effectiveDate = effectiveDate.serialNumber();
+        key.terminationDate = terminationDate.serialNumber();
+        key.tenorLength = tenor.length();
+        key.tenorUnits = tenor.units();
+        key.calendar = calendar.empty() ? std::string() : calendar.name();
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate.serialNumber();
+        key.nextToLastDate = nextToLastDate.serialNumber();
+
+        std::map<Key, ext::shared_ptr<const Schedule> >::iterator i =
+            schedules_.lower_bound(key);
+        if (i == schedules_.end() || key < i->first) {
+            ext::shared_ptr<const Schedule> s =
+                ext::make_shared<Schedule>(effectiveDate, terminationDate,
+                                           tenor, calendar, convention,
+                                           terminationDateConvention,
+                                           rule, endOfMonth,
+                                           firstDate, nextToLastDate);
+            i = schedules_.insert(i, std::make_pair(key, s));
+        }
+        return i->second;
+    }
+
+    std::vector<ext::shared_ptr<const Schedule> > ScheduleCache::schedules(
+                               const std::vector<Date>& effectiveDates,
+                               const std::vector<Date>& terminationDates,
+                               const std::vector<Period>& tenors,
+                               const Calendar& calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth) {
+        Size n = effectiveDates.size();
+        QL_REQUIRE(terminationDates.size() == n,
+                   "number of termination dates (" << terminationDates.size()
+                   << ") different from number of effective dates ("
+                   << n << ")");
+        QL_REQUIRE(tenors.size() == n,
+                   "number of tenors (" << tenors.size()
+                   << ") different from number of effective dates ("
+                   << n << ")");
+
+        std::vector<ext::shared_ptr<const Schedule> > result(n);
+        for (Size i=0; i<n; ++i) {
+            // consecutive trades often share the same schedule
+            if (i > 0 &&
+                effectiveDates[i] == effectiveDates[i-1] &&
+                effectiveDates[i] != Date() &&
+                terminationDates[i] == terminationDates[i-1] &&
+                tenors[i].length() == tenors[i-1].length() &&
+                tenors[i].units() == tenors[i-1].units()) {
+                result[i] = result[i-1];
+            } else {
+                result[i] = schedule(effectiveDates[i], terminationDates[i],
+                                     tenors[i], calendar, convention,
+                                     terminationDateConvention,
+                                     rule, endOfMonth);
+            }
+        }
+        return result;
+    }
+
+    Size ScheduleCache::size() const {
+        return schedules_.size();
+    }
+
+    void ScheduleCache::clear() {
+        schedules_.clear();
+    }
+
+}
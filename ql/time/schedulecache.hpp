@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief cache of rule-based schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <ql/shared_ptr.hpp>
+#include <map>
+#include <string>
+
+namespace QuantLib {
+
+    //! cache of rule-based schedules
+    /*! Loading a large number of trades usually requires the same
+        few schedules over and over.  This class generates each
+        schedule once, the first time it is requested, and returns
+        the same immutable instance for all subsequent requests with
+        the same parameters.
+
+        Schedules with a null effective date, whose generation depends
+        on the evaluation date, are generated at each request and not
+        stored.
+
+        \warning calendars are identified by their name; if holidays
+                 are added to or removed from a calendar after some
+                 of its schedules were cached, the cache must be
+                 cleared.
+
+        \warning the class is not thread-safe.
+
+        \ingroup datetime
+    */
+    class ScheduleCache {
+      public:
+        //! returns the schedule with the given parameters
+        /*! The arguments are the same as those of the rule-based
+            Schedule constructor.
+        */
+        ext::shared_ptr<const Schedule> schedule(
+                               const Date& effectiveDate,
+                               const Date& terminationDate,
+                               const Period& tenor,
+                               const Calendar& calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth,
+                               const Date& firstDate = Date(),
+                               const Date& nextToLastDate = Date());
+        //! returns the schedules for a set of trades
+        /*! The effective dates, termination dates and tenors of the
+            trades are passed as columns of equal size; the other
+            parameters are shared by all the schedules.
+        */
+        std::vector<ext::shared_ptr<const Schedule> > schedules(
+                               const std::vector<Date>& effectiveDates,
+                               const std::vector<Date>& terminationDates,
+                               const std::vector<Period>& tenors,
+                               const Calendar& calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth);
+        //! number of cached schedules
+        Size size() const;
+        //! removes all cached schedules
+        void clear();
+      private:
+        struct Key {
+            Date::serial_type effectiveDate, terminationDate;
+            Integer tenorLength;
+            Integer tenorUnits;
+            std::string calendar;
+            Integer convention, terminationDateConvention;
+            Integer rule;
+            bool endOfMonth;
+            Date::serial_type firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        std::map<Key, ext::shared_ptr<const Schedule> > schedules_;
+    };
+
+}
+
+
+#endif
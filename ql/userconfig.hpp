@@ -67,6 +67,14 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to allow threads to use their own copy of the settings
+   (e.g., of the evaluation date) by means of the LocalSettings class.
+   This requires you to set your compiler's standard to at least C++11
+   and is not supported when sessions are enabled. */
+#ifndef QL_ENABLE_THREAD_LOCAL_SETTINGS
+//#    define QL_ENABLE_THREAD_LOCAL_SETTINGS
+#endif
+
 /* Define this to enable the thread-safe observer pattern. You should
    enable it if you want to use QuantLib via the SWIG layer within
    the JVM or .NET eco system or any environment with an
@@ -107,6 +115,14 @@
 //#    define QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
 #endif
 
+/* Define this to use BLAS and LAPACK for dense matrix products and
+   for the Cholesky, symmetric Schur and singular value decompositions.
+   You will have to link the library with BLAS and LAPACK libraries
+   (e.g., OpenBLAS.)  This requires Real to be double. */
+#ifndef QL_USE_LAPACK
+//#    define QL_USE_LAPACK
+#endif
+
 /* Define this to make Singleton initialization thread-safe.
    Note: There is no support for thread safety and multiple sessions.
 */
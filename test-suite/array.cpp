@@ -207,6 +207,128 @@ void ArrayTest::testArrayFunctions() {
     }
 }
 
+void ArrayTest::testArrayStorage() {
+
+    BOOST_TEST_MESSAGE("Testing array storage...");
+
+    // sizes below, at and above the inline storage
+    const Size sizes[] = { 0, 1, 3, 4, 5, 17 };
+    const Size nSizes = LENGTH(sizes);
+
+    for (Size i=0; i<nSizes; ++i) {
+        for (Size j=0; j<nSizes; ++j) {
+            Array a(sizes[i], 1.0, 1.0), b(sizes[j], -1.0, -1.0);
+            const Array a0 = a, b0 = b;
+
+            a.swap(b);
+            if (a != b0 || b != a0)
+                BOOST_FAIL("swapping arrays of size " << sizes[i]
+                           << " and " << sizes[j] << " failed");
+
+            Array c(a0);
+            c = b0;
+            if (c != b0)
+                BOOST_FAIL("assigning array of size " << sizes[j]
+                           << " to array of size " << sizes[i] << " failed");
+
+            Array d(a0);
+            d.resize(sizes[j]);
+            for (Size k=0; k<std::min(sizes[i], sizes[j]); ++k) {
+                if (d[k] != a0[k])
+                    BOOST_FAIL("resizing array of size " << sizes[i]
+                               << " to " << sizes[j] << " failed");
+            }
+        }
+
+        // returning through a Disposable moves the storage
+        const Array a = -Array(sizes[i], 1.0, 1.0);
+        for (Size k=0; k<sizes[i]; ++k) {
+            if (a[k] != -Real(k+1))
+                BOOST_FAIL("returning array of size " << sizes[i]
+                           << " failed");
+        }
+
+        Array e(sizes[i], 2.0);
+        e.swap(e);
+        if (e != Array(sizes[i], 2.0))
+            BOOST_FAIL("self-swapping array of size " << sizes[i]
+                       << " failed");
+    }
+
+    const Array large(100, 1.0);
+    if (reinterpret_cast<std::size_t>(large.begin()) % 64 != 0)
+        BOOST_FAIL("large array storage not aligned on 64-byte boundary");
+}
+
+void ArrayTest::testArrayExpressions() {
+
+    BOOST_TEST_MESSAGE("Testing array expressions with temporaries...");
+
+    const Size n = 7;
+    Array x(n), y(n), z(n);
+    for (Size i=0; i < n; ++i) {
+        x[i] = std::sin(Real(i))+1.1;
+        y[i] = std::cos(Real(i))+1.2;
+        z[i] = 0.5*i+0.3;
+    }
+    const Real a = 1.7, b = -0.4;
+
+    const Array r1 = a*x + b*y - z;
+    const Array r2 = z - x*y;
+    const Array r3 = z / (x+y);
+    const Array r4 = (x-y) / (y-z);
+    const Array r5 = 2.0 - (x*y) / 3.0;
+    const Array r6 = 1.0 / Exp(-x) + Sqrt(Abs(y-z));
+    const Array r7 = -(x+y) * Log(2.0*z) - Pow(x*x, 0.5);
+
+    for (Size i=0; i < n; ++i) {
+        const Real e1 = a*x[i] + b*y[i] - z[i];
+        const Real e2 = z[i] - x[i]*y[i];
+        const Real e3 = z[i] / (x[i]+y[i]);
+        const Real e4 = (x[i]-y[i]) / (y[i]-z[i]);
+        const Real e5 = 2.0 - (x[i]*y[i]) / 3.0;
+        const Real e6 = 1.0/std::exp(-x[i]) + std::sqrt(std::fabs(y[i]-z[i]));
+        const Real e7 = -(x[i]+y[i]) * std::log(2.0*z[i])
+                      - std::pow(x[i]*x[i], 0.5);
+        const Real tol = 1.0e-14;
+        if (std::fabs(r1[i]-e1) > tol || std::fabs(r2[i]-e2) > tol
+            || std::fabs(r3[i]-e3) > tol || std::fabs(r4[i]-e4) > tol
+            || std::fabs(r5[i]-e5) > tol || std::fabs(r6[i]-e6) > tol
+            || std::fabs(r7[i]-e7) > tol) {
+            BOOST_FAIL("array expression test failed at element " << i);
+        }
+    }
+
+    // operands are left untouched
+    for (Size i=0; i < n; ++i) {
+        if (x[i] != std::sin(Real(i))+1.1 || z[i] != 0.5*i+0.3) {
+            BOOST_FAIL("array expression modified its operands");
+        }
+    }
+
+    BOOST_CHECK_THROW(x*y + Array(n+1, 1.0), Error);
+    BOOST_CHECK_THROW(x - (y+Array(n+1, 1.0)), Error);
+
+    // aliased operands are read, not stolen
+    const Disposable<Array>& d = x+y;
+    const Array& ref = d;
+    const Array s1 = d + d;
+    const Array s2 = d * d;
+    const Array s3 = d - ref;
+    const Array s4 = ref / d;
+    if (d.size() != n)
+        BOOST_FAIL("aliased operand emptied by array expression");
+    for (Size i=0; i < n; ++i) {
+        const Real e = x[i]+y[i];
+        const Real tol = 1.0e-14;
+        if (std::fabs(s1[i]-2.0*e) > tol || std::fabs(s2[i]-e*e) > tol
+            || std::fabs(s3[i]) > tol || std::fabs(s4[i]-1.0) > tol) {
+            BOOST_FAIL("aliased array expression test failed "
+                       "at element " << i);
+        }
+    }
+}
+
 void ArrayTest::testArrayResize() {
     BOOST_TEST_MESSAGE("Testing array resize...");
 
@@ -242,6 +364,8 @@ test_suite* ArrayTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayResize));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayExpressions));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayStorage));
     return suite;
 }
 
@@ -30,6 +30,8 @@ class ArrayTest {
     static void testConstruction();
     static void testArrayFunctions();
     static void testArrayResize();
+    static void testArrayExpressions();
+    static void testArrayStorage();
     static boost::unit_test_framework::test_suite* suite();
 };
 
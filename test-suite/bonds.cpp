@@ -45,6 +45,10 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/experimental/callablebonds/discretizedcallablefixedratebond.hpp>
+#include <ql/experimental/callablebonds/treecallablebondengine.hpp>
+#include <ql/experimental/callablebonds/treecallablebondportfoliopricer.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1526,6 +1530,107 @@ void BondTest::testThirty360BondWithSettlementOn31st(){
     ASSERT_CLOSE("accrued", settlement, accrued, 0.7, 1e-6);
 }
 
+void BondTest::testCallableBondPortfolio() {
+    BOOST_TEST_MESSAGE(
+        "Testing callable bonds priced together on a common lattice...");
+
+    SavedSettings backup;
+    Date today(15, March, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    DayCounter dayCounter = Actual365Fixed();
+    Handle<YieldTermStructure> termStructure(
+                                        flatRate(today, 0.04, dayCounter));
+    ext::shared_ptr<ShortRateModel> model =
+        ext::make_shared<HullWhite>(termStructure, 0.06, 0.01);
+
+    Integer maturities[] = { 10, 5, 7, 10 };
+    Rate coupons[] = { 0.05, 0.04, 0.045, 0.03 };
+    std::vector<ext::shared_ptr<CallableBond> > bonds;
+    for (Size i=0; i<LENGTH(maturities); ++i) {
+        Schedule schedule(today, today + maturities[i]*Years,
+                          Period(Annual), NullCalendar(),
+                          Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        CallabilitySchedule callability;
+        for (Integer j=3; j<maturities[i]; ++j)
+            callability.push_back(ext::make_shared<Callability>(
+                        Callability::Price(100.0, Callability::Price::Clean),
+                        Callability::Call, today + j*Years));
+        bonds.push_back(ext::make_shared<CallableFixedRateBond>(
+                                 3, 100.0, schedule,
+                                 std::vector<Rate>(1, coupons[i]),
+                                 Thirty360(), Unadjusted, 100.0, today,
+                                 callability));
+    }
+
+    // the times of the longest bond include those of the others
+    CallableBond::arguments arguments;
+    bonds[0]->setupArguments(&arguments);
+    std::vector<Time> times =
+        DiscretizedCallableFixedRateBond(arguments, today, dayCounter)
+        .mandatoryTimes();
+    TimeGrid grid(times.begin(), times.end(), 200);
+
+    ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<TreeCallableFixedRateBondEngine>(model, grid);
+    TreeCallableBondPortfolioPricer pricer(model, grid);
+
+    std::vector<Real> values = pricer.values(bonds);
+    std::vector<Real> cleanPrices(bonds.size());
+    for (Size i=0; i<bonds.size(); ++i) {
+        bonds[i]->setPricingEngine(engine);
+        Real expected = bonds[i]->NPV();
+        if (std::fabs(values[i] - expected) > 1.0e-10)
+            BOOST_ERROR("failed to reproduce single-bond value"
+                        << "\n    bond:       " << i+1
+                        << std::setprecision(12)
+                        << "\n    calculated: " << values[i]
+                        << "\n    expected:   " << expected);
+        cleanPrices[i] = bonds[i]->cleanPrice() - 1.0;
+    }
+
+    std::vector<Spread> spreads =
+        pricer.OAS(bonds, cleanPrices, termStructure, dayCounter,
+                   Continuous, NoFrequency);
+    for (Size i=0; i<bonds.size(); ++i) {
+        Spread expected = bonds[i]->OAS(cleanPrices[i], termStructure,
+                                        dayCounter, Continuous, NoFrequency);
+        if (std::fabs(spreads[i] - expected) > 1.0e-8)
+            BOOST_ERROR("failed to reproduce single-bond OAS"
+                        << "\n    bond:       " << i+1
+                        << std::setprecision(12)
+                        << "\n    calculated: " << spreads[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    // the spreads used in the OAS calculations must not affect the
+    // lattices kept by the engines
+    ext::shared_ptr<PricingEngine> engineWithSteps =
+        ext::make_shared<TreeCallableFixedRateBondEngine>(model, 100);
+    for (Size i=0; i<bonds.size(); ++i) {
+        bonds[i]->recalculate();
+        if (std::fabs(bonds[i]->NPV() - values[i]) > 1.0e-10)
+            BOOST_ERROR("value changed after OAS calculation"
+                        << "\n    bond:      " << i+1
+                        << std::setprecision(12)
+                        << "\n    before:    " << values[i]
+                        << "\n    after:     " << bonds[i]->NPV());
+
+        bonds[i]->setPricingEngine(engineWithSteps);
+        Real before = bonds[i]->NPV();
+        bonds[i]->OAS(cleanPrices[i], termStructure,
+                      dayCounter, Continuous, NoFrequency);
+        bonds[i]->recalculate();
+        if (std::fabs(bonds[i]->NPV() - before) > 1.0e-10)
+            BOOST_ERROR("value changed after OAS calculation"
+                        << "\n    bond:      " << i+1
+                        << std::setprecision(12)
+                        << "\n    before:    " << before
+                        << "\n    after:     " << bonds[i]->NPV());
+    }
+}
+
 test_suite* BondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bond tests");
 
@@ -1542,6 +1647,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testExCouponAustralianBond));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testBondFromScheduleWithDateVector));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testThirty360BondWithSettlementOn31st));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testCallableBondPortfolio));
     return suite;
 }
 
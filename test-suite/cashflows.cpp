@@ -24,11 +24,13 @@
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/compactleg.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/settings.hpp>
@@ -420,6 +422,128 @@ void CashFlowsTest::testPartialScheduleLegConstruction() {
     BOOST_CHECK_EQUAL(lastCpnF3->referencePeriodEnd(), Date(30, Sep, 2020));
 }
 
+void CashFlowsTest::testCompactLeg() {
+    BOOST_TEST_MESSAGE("Testing compact legs against the corresponding coupons...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today = Date(15, March, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> curve(flatRate(today, 0.03, Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new USDLibor(6*Months, curve));
+
+    // both the first and the last coupons are irregular
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(10, January, 2019)).to(Date(20, November, 2024))
+        .withFirstDate(Date(30, April, 2019))
+        .withNextToLastDate(Date(31, October, 2023))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing)
+        .endOfMonth();
+
+    std::vector<Real> nominals(3, 100.0);
+    nominals[1] = 90.0;
+    nominals[2] = 80.0;
+    std::vector<Rate> rates(2, 0.04);
+    rates[1] = 0.045;
+    std::vector<Spread> spreads(1, 0.002);
+    std::vector<Real> gearings(1, 1.5);
+
+    Leg fixedLeg = FixedRateLeg(schedule)
+        .withNotionals(nominals)
+        .withCouponRates(rates, Thirty360(), Compounded, Semiannual)
+        .withPaymentLag(2);
+    CompactLeg compactFixedLeg(schedule, nominals, rates, Thirty360(),
+                               Compounded, Semiannual, Following, 2);
+
+    Leg iborLeg = IborLeg(schedule, index)
+        .withNotionals(nominals)
+        .withGearings(gearings)
+        .withSpreads(spreads)
+        .withPaymentDayCounter(Actual360());
+    CompactLeg compactIborLeg(schedule, index, nominals, gearings, spreads,
+                              Actual360());
+
+    // the first Ibor coupon has fixed already
+    index->addFixing(compactIborLeg.fixingDates()[0], 0.025);
+
+    Real tolerance = 1.0e-10;
+
+    const Leg* legs[] = { &fixedLeg, &iborLeg };
+    const CompactLeg* compactLegs[] = { &compactFixedLeg, &compactIborLeg };
+
+    for (Size k=0; k<2; ++k) {
+        const Leg& leg = *legs[k];
+        const CompactLeg& compactLeg = *compactLegs[k];
+        Leg convertedLeg = compactLeg.toLeg();
+
+        BOOST_REQUIRE(compactLeg.size() == leg.size());
+        BOOST_REQUIRE(convertedLeg.size() == leg.size());
+
+        for (Size i=0; i<leg.size(); ++i) {
+            ext::shared_ptr<Coupon> c =
+                ext::dynamic_pointer_cast<Coupon>(leg[i]);
+            BOOST_CHECK_EQUAL(compactLeg.paymentDates()[i], c->date());
+            BOOST_CHECK_EQUAL(compactLeg.referencePeriodStarts()[i],
+                              c->referencePeriodStart());
+            BOOST_CHECK_EQUAL(compactLeg.referencePeriodEnds()[i],
+                              c->referencePeriodEnd());
+            if (std::fabs(compactLeg.amount(i) - c->amount()) > tolerance)
+                BOOST_ERROR("coupon amount mismatch for coupon " << i
+                            << " of leg " << k << ":"
+                            << "\n    compact leg: " << compactLeg.amount(i)
+                            << "\n    coupon:      " << c->amount());
+            if (std::fabs(convertedLeg[i]->amount() - c->amount())
+                                                               > tolerance)
+                BOOST_ERROR("converted amount mismatch for coupon " << i
+                            << " of leg " << k << ":"
+                            << "\n    converted leg: "
+                            << convertedLeg[i]->amount()
+                            << "\n    coupon:        " << c->amount());
+        }
+
+        BOOST_CHECK_EQUAL(CashFlows::startDate(compactLeg),
+                          CashFlows::startDate(leg));
+        BOOST_CHECK_EQUAL(CashFlows::maturityDate(compactLeg),
+                          CashFlows::maturityDate(leg));
+
+        Date settlementDates[] = { today, Date(30, April, 2019),
+                                   Date(3, June, 2021) };
+        for (Size j=0; j<LENGTH(settlementDates); ++j) {
+            Date d = settlementDates[j];
+            Real expected, calculated;
+
+            expected = CashFlows::npv(leg, **curve, false, d);
+            calculated = CashFlows::npv(compactLeg, **curve, false, d);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("NPV mismatch for leg " << k
+                            << " at " << d << ":"
+                            << "\n    compact leg: " << calculated
+                            << "\n    coupons:     " << expected);
+
+            expected = CashFlows::bps(leg, **curve, false, d);
+            calculated = CashFlows::bps(compactLeg, **curve, false, d);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("BPS mismatch for leg " << k
+                            << " at " << d << ":"
+                            << "\n    compact leg: " << calculated
+                            << "\n    coupons:     " << expected);
+
+            expected = CashFlows::accruedAmount(leg, false, d);
+            calculated = CashFlows::accruedAmount(compactLeg, false, d);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("accrued amount mismatch for leg " << k
+                            << " at " << d << ":"
+                            << "\n    compact leg: " << calculated
+                            << "\n    coupons:     " << expected);
+        }
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -434,5 +558,6 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testPartialScheduleLegConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompactLeg));
     return suite;
 }
@@ -24,9 +24,14 @@
 #include <ql/experimental/credit/integralcdoengine.hpp>
 #include <ql/experimental/credit/midpointcdoengine.hpp>
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
+#include <ql/experimental/credit/randomlosslatentmodel.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/binomiallossmodel.hpp>
+#include <ql/experimental/credit/saddlepointlossmodel.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -38,6 +43,9 @@
 #include <boost/preprocessor/iteration/local.hpp>
 #include <iomanip>
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace std;
@@ -221,6 +229,12 @@ void CdoTest::testHW(unsigned dataSet) {
         // Binomial...
         // Saddle point...
         // Recursive ...
+        modelNames.push_back("Recursive gaussian");
+        basketModels.push_back(ext::shared_ptr<DefaultLossModel>(new
+            RecursiveGaussLossModel(gaussKtLossLM)));
+        absoluteTolerance.push_back(1.);
+        relativeToleranceMidp.push_back(0.04);
+        relativeTolerancePeriod.push_back(0.04);
     }
     else if (hwData7[i].nm > 0 && hwData7[i].nz > 0) {
         TCopulaPolicy::initTraits initTG;
@@ -368,9 +382,317 @@ void CdoTest::testHW(unsigned dataSet) {
 }
 
 
+void CdoTest::testStreamedRandomDefaultStatistics() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing streamed tail statistics of random default "
+                       "latent models...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+    Date horizon = asofDate + 5*Years;
+
+    Size poolSize = 40;
+    Real recovery = 0.4;
+    Size numSims = 4000;
+
+    ext::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate, Handle<Quote>(
+            ext::shared_ptr<Quote>(new SimpleQuote(0.02))), ActualActual()));
+    ext::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0,Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.3))),
+        std::vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > model_type;
+    ext::shared_ptr<model_type> model(new model_type(lm, numSims));
+
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.0, 0.3));
+    basket->setLossModel(model);
+
+    Real expectedLoss = basket->expectedTrancheLoss(horizon);
+    Real var95 = basket->percentile(horizon, 0.95);
+    Real var99 = basket->percentile(horizon, 0.99);
+    Real esf95 = basket->expectedShortfall(horizon, 0.95);
+    Probability atLeast3 = basket->probAtLeastNEvents(3, horizon);
+    Real splitLevel = basket->percentile(horizon, 0.9);
+    vector<Real> split = basket->splitVaRLevel(horizon, splitLevel);
+
+    model->streamStatistics(vector<Date>(1, horizon), 0.1);
+
+    const Real tolerance = 1.0e-10;
+    Real streamed[] = {
+        basket->expectedTrancheLoss(horizon),
+        basket->percentile(horizon, 0.95),
+        basket->percentile(horizon, 0.99),
+        basket->expectedShortfall(horizon, 0.95),
+        basket->probAtLeastNEvents(3, horizon) };
+    Real stored[] = { expectedLoss, var95, var99, esf95, atLeast3 };
+    const char* labels[] = { "expected tranche loss", "95% percentile",
+                             "99% percentile", "95% expected shortfall",
+                             "probability of 3 or more defaults" };
+    for (Size i=0; i<LENGTH(stored); ++i) {
+        if (std::fabs(streamed[i] - stored[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce " << labels[i]
+                        << " when streaming"
+                        << "\n    stored:   " << stored[i]
+                        << "\n    streamed: " << streamed[i]);
+    }
+
+    vector<Real> streamedSplit = basket->splitVaRLevel(horizon, splitLevel);
+    for (Size i=0; i<split.size(); ++i) {
+        if (std::fabs(streamedSplit[i] - split[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce VaR split for name " << i
+                        << " when streaming"
+                        << "\n    stored:   " << split[i]
+                        << "\n    streamed: " << streamedSplit[i]);
+    }
+
+    // levels below the retained tail are not available
+    BOOST_CHECK_THROW(basket->percentile(horizon, 0.5), Error);
+    #endif
+}
+
+
+void CdoTest::testExpectedTrancheLossSurface() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing multi-date expected tranche losses "
+                       "against single date values...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 12;
+    Real recovery = 0.4;
+    Real hazardRates[] = { 0.01, 0.02, 0.04 };
+
+    ext::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(
+                ext::make_shared<FlatHazardRate>(asofDate, 
+                    Handle<Quote>(ext::make_shared<SimpleQuote>(
+                        hazardRates[i % LENGTH(hazardRates)])), 
+                    ActualActual()))));
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    vector<Date> dates;
+    for (Size i=0; i<=20; ++i)
+        dates.push_back(asofDate + Period(3*i, Months));
+
+    Handle<Quote> correlation(ext::make_shared<SimpleQuote>(0.3));
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        correlation, vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    vector<ext::shared_ptr<DefaultLossModel> > models;
+    vector<string> modelNames;
+    models.push_back(ext::make_shared<RecursiveGaussLossModel>(lm));
+    modelNames.push_back("recursive");
+    models.push_back(ext::make_shared<GaussianBinomialLossModel>(lm));
+    modelNames.push_back("binomial");
+    models.push_back(
+        ext::make_shared<SaddlePointLossModel<GaussianCopulaPolicy> >(lm));
+    modelNames.push_back("saddle point");
+
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.03, 0.1));
+
+    // the scalar and vector gaussian quadratures do not share their nodes
+    const Real tolerance = 1.0e-6;
+    for (Size im=0; im<models.size(); ++im) {
+        basket->setLossModel(models[im]);
+        vector<Real> losses = basket->expectedTrancheLosses(dates);
+        for (Size i=0; i<dates.size(); ++i) {
+            Real loss = basket->expectedTrancheLoss(dates[i]);
+            if (std::fabs(losses[i] - loss) > tolerance)
+                BOOST_ERROR("failed to reproduce " << modelNames[im]
+                            << " expected tranche loss on " << dates[i]
+                            << "\n    single date: " << loss
+                            << "\n    multi-date:  " << losses[i]);
+        }
+    }
+
+    ext::shared_ptr<DefaultLossModel> ntdModel(
+        new ConstantLossModel<GaussianCopulaPolicy>(correlation,
+            vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+    basket->setLossModel(ntdModel);
+    for (Size n=1; n<=3; ++n) {
+        vector<Probability> probs = basket->probsAtLeastNEvents(n, dates);
+        for (Size i=0; i<dates.size(); ++i) {
+            Probability prob = basket->probAtLeastNEvents(n, dates[i]);
+            if (std::fabs(probs[i] - prob) > 1.0e-8)
+                BOOST_ERROR("failed to reproduce probability of " << n
+                            << " or more defaults on " << dates[i]
+                            << "\n    single date: " << prob
+                            << "\n    multi-date:  " << probs[i]);
+        }
+    }
+    #endif
+}
+
+
+void CdoTest::testParallelRandomDefaultStatistics() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing random default latent models "
+                       "against single-threaded simulations...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+    Date horizon = asofDate + 5*Years;
+
+    Size poolSize = 20;
+    Real recovery = 0.4;
+    Real hazardRates[] = { 0.01, 0.02, 0.04 };
+    Size numSims = 5000;
+
+    ext::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<Handle<DefaultProbabilityTermStructure> > curves;
+    for (Size i=0; i<LENGTH(hazardRates); ++i)
+        curves.push_back(Handle<DefaultProbabilityTermStructure>(
+            ext::make_shared<FlatHazardRate>(asofDate,
+                Handle<Quote>(ext::make_shared<SimpleQuote>(hazardRates[i])),
+                ActualActual())));
+    Real expectedLoss = 0.0;
+    for (Size i=0; i<poolSize; ++i) {
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            curves[i % curves.size()]));
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+        expectedLoss += 100.0 * (1.0 - recovery)
+            * curves[i % curves.size()]->defaultProbability(horizon);
+    }
+
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.3)),
+        vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+    vector<vector<Real> > weightsRR(2*poolSize,
+                                    vector<Real>(1, std::sqrt(0.3)));
+    ext::shared_ptr<GaussianSpotLossLM> spotLM(new GaussianSpotLossLM(
+        weightsRR, vector<Real>(poolSize, recovery), 2.2,
+        LatentModelIntegrationType::GaussianQuadrature,
+        GaussianCopulaPolicy::initTraits()));
+
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > default_type;
+    typedef RandomLossLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > loss_type;
+
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.0, 1.0));
+
+    const char* modelNames[] = { "random default", "random loss" };
+    const char* labels[] = { "expected tranche loss", "95% percentile",
+                             "95% expected shortfall",
+                             "probability of 3 or more defaults" };
+    for (Size im=0; im<LENGTH(modelNames); ++im) {
+        Real results[2][4];
+        // the first run is on a single thread, the second on all of them
+        for (Size run=0; run<2; ++run) {
+            #ifdef _OPENMP
+            int maxThreads = omp_get_max_threads();
+            if (run == 0)
+                omp_set_num_threads(1);
+            #endif
+            ext::shared_ptr<DefaultLossModel> model;
+            if (im == 0)
+                model = ext::make_shared<default_type>(lm,
+                    vector<Real>(poolSize, recovery), numSims);
+            else
+                model = ext::make_shared<loss_type>(spotLM, numSims);
+            basket->setLossModel(model);
+            results[run][0] = basket->expectedTrancheLoss(horizon);
+            results[run][1] = basket->percentile(horizon, 0.95);
+            results[run][2] = basket->expectedShortfall(horizon, 0.95);
+            results[run][3] = basket->probAtLeastNEvents(3, horizon);
+            #ifdef _OPENMP
+            omp_set_num_threads(maxThreads);
+            #endif
+        }
+
+        // samples are drawn serially, so results must match exactly
+        for (Size i=0; i<LENGTH(labels); ++i) {
+            if (std::fabs(results[1][i] - results[0][i]) > 1.0e-10)
+                BOOST_ERROR("failed to reproduce " << modelNames[im]
+                            << " " << labels[i] << " across threads"
+                            << "\n    single thread: " << results[0][i]
+                            << "\n    all threads:   " << results[1][i]);
+        }
+
+        // the expected loss of the whole basket doesn't depend on the
+        // correlation; the spot recovery model preserves it as well
+        Real tolerance = 0.05 * expectedLoss;
+        if (std::fabs(results[1][0] - expectedLoss) > tolerance)
+            BOOST_ERROR("failed to reproduce expected loss with "
+                        << modelNames[im] << " model"
+                        << "\n    calculated: " << results[1][0]
+                        << "\n    expected:   " << expectedLoss
+                        << "\n    tolerance:  " << tolerance);
+    }
+    #endif
+}
+
+
 test_suite* CdoTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     #ifndef QL_PATCH_SOLARIS
+    suite->add(QUANTLIB_TEST_CASE(
+        &CdoTest::testStreamedRandomDefaultStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testExpectedTrancheLossSurface));
+    suite->add(QUANTLIB_TEST_CASE(
+        &CdoTest::testParallelRandomDefaultStatistics));
     if (speed == Slow) {
         #define BOOST_PP_LOCAL_MACRO(n) \
             suite->add(QUANTLIB_TEST_CASE(ext::bind(&CdoTest::testHW, n)));
@@ -29,6 +29,9 @@
 class CdoTest {
   public:
     static void testHW(unsigned dataSet);
+    static void testStreamedRandomDefaultStatistics();
+    static void testExpectedTrancheLossSurface();
+    static void testParallelRandomDefaultStatistics();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -119,8 +119,67 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
+void CreditRiskPlusTest::testFourierTransform() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit risk plus loss distribution by Fourier transform...");
+
+    std::vector<Real> exposure, pd;
+    std::vector<Size> sector;
+    for (Size i = 0; i < 3000; ++i) {
+        exposure.push_back(0.5 + (i % 7) * 0.75);
+        pd.push_back(0.005 + (i % 11) * 0.003);
+        sector.push_back(i % 3);
+    }
+
+    std::vector<Real> relativeDefaultVariance;
+    relativeDefaultVariance.push_back(0.75 * 0.75);
+    relativeDefaultVariance.push_back(0.5 * 0.5);
+    relativeDefaultVariance.push_back(0.9 * 0.9);
+
+    Matrix rho(3, 3, 0.25);
+    for (Size i = 0; i < 3; ++i)
+        rho[i][i] = 1.0;
+
+    Real unit = 0.25;
+
+    CreditRiskPlus panjer(exposure, pd, sector, relativeDefaultVariance, rho,
+                          unit, CreditRiskPlus::PanjerRecursion);
+    CreditRiskPlus fourier(exposure, pd, sector, relativeDefaultVariance, rho,
+                           unit, CreditRiskPlus::FourierTransform);
+
+    const std::vector<Real>& panjerLoss = panjer.loss();
+    const std::vector<Real>& fourierLoss = fourier.loss();
+
+    if (panjerLoss.size() != fourierLoss.size())
+        BOOST_FAIL("loss distribution sizes differ ("
+                   << panjerLoss.size() << " and " << fourierLoss.size()
+                   << ")");
+
+    static const Real tol = 1E-12;
+
+    for (Size i = 0; i < panjerLoss.size(); ++i) {
+        if (std::fabs(panjerLoss[i] - fourierLoss[i]) > tol)
+            BOOST_FAIL("failed to reproduce the recursive loss distribution "
+                       "at " << i * unit << " ("
+                       << fourierLoss[i] << ", should be " << panjerLoss[i]
+                       << ")");
+    }
+
+    Real quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    for (Size i = 0; i < LENGTH(quantiles); ++i) {
+        if (std::fabs(panjer.lossQuantile(quantiles[i]) -
+                      fourier.lossQuantile(quantiles[i])) > 1E-4)
+            BOOST_FAIL("failed to reproduce the recursive "
+                       << quantiles[i] << " loss quantile ("
+                       << fourier.lossQuantile(quantiles[i]) << ", should be "
+                       << panjer.lossQuantile(quantiles[i]) << ")");
+    }
+}
+
 test_suite *CreditRiskPlusTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testReferenceValues));
+    suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testFourierTransform));
     return suite;
 }
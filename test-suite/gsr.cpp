@@ -285,9 +285,78 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testGridCache() {
+
+    BOOST_TEST_MESSAGE("Testing GSR model grid cache...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    Handle<YieldTermStructure> yts(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 10; i++)
+        stepDates.push_back(refDate + (i * Years));
+    std::vector<ext::shared_ptr<SimpleQuote> > volQuotes;
+    std::vector<Handle<Quote> > vols;
+    for (Size i = 0; i < stepDates.size() + 1; i++) {
+        volQuotes.push_back(ext::make_shared<SimpleQuote>(0.01));
+        vols.push_back(Handle<Quote>(volQuotes.back()));
+    }
+    Handle<Quote> reversion(ext::make_shared<SimpleQuote>(0.02));
+
+    ext::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversion, 30.0));
+    ext::shared_ptr<IborIndex> iborIndex(new Euribor6M(yts));
+
+    const Real stdDevs = 7.0;
+    const int points = 16;
+    const Time t = 5.0, T = 12.0;
+    const Date fixing = TARGET().advance(refDate, 7 * Years);
+    const Date reference = TARGET().advance(refDate, 5 * Years);
+    const Real tol = 1E-14;
+
+    for (Size run = 0; run < 3; ++run) {
+        if (run == 1) {
+            // quote changes are propagated to the cache
+            volQuotes[4]->setValue(0.015);
+        }
+        if (run == 2) {
+            // calibration changes are propagated to the cache
+            Array params = model->params();
+            for (Size i = 1; i < params.size(); ++i)
+                params[i] = 0.005;
+            model->setParams(params);
+        }
+        Array z = model->yGrid(stdDevs, points);
+        // query twice, so that the second call is served from the cache
+        for (Size k = 0; k < 2; ++k) {
+            Array zb = model->zerobondGrid(T, t, stdDevs, points);
+            Array nu = model->numeraireGrid(t, stdDevs, points);
+            Array fwd = model->forwardRateGrid(fixing, reference, stdDevs,
+                                               points, iborIndex);
+            for (Size i = 0; i < z.size(); ++i) {
+                Real zb0 = model->zerobond(T, t, z[i]);
+                Real nu0 = model->numeraire(t, z[i]);
+                Real fwd0 =
+                    model->forwardRate(fixing, reference, z[i], iborIndex);
+                if (std::fabs(zb[i] - zb0) > tol ||
+                    std::fabs(nu[i] - nu0) > tol ||
+                    std::fabs(fwd[i] - fwd0) > tol)
+                    BOOST_ERROR("cached grid values ("
+                                << zb[i] << ", " << nu[i] << ", " << fwd[i]
+                                << ") differ from direct computation ("
+                                << zb0 << ", " << nu0 << ", " << fwd0
+                                << ") at y=" << z[i] << " in run " << run);
+            }
+        }
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGridCache));
     return suite;
 }
@@ -30,6 +30,7 @@ class GsrTest {
     static void testGsrProcess();
     static void testGsrModel();
     static void testNonstandardSwaption();
+    static void testGridCache();
     static void testDummy();
     static boost::unit_test_framework::test_suite *suite();
 };
@@ -36,6 +36,8 @@
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/interpolations/convexmonotoneinterpolation.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/math/bspline.hpp>
 #include <ql/math/kernelfunctions.hpp>
@@ -2446,6 +2448,77 @@ void InterpolationTest::testBackwardFlatOnSinglePoint() {
     }
 }
 
+namespace {
+
+    void checkBatchEvaluation(const std::string& name,
+                              const Interpolation& f,
+                              const std::vector<Real>& x) {
+        std::vector<Real> y(x.size());
+        f(&x[0], &y[0], x.size(), true);
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = f(x[i], true);
+            if (std::fabs(y[i] - expected) > 1e-14*std::fabs(expected)) {
+                BOOST_FAIL("batch evaluation of " << name
+                           << " interpolation failed"
+                           << "\n   x         : " << x[i]
+                           << "\n   expected  : " << expected
+                           << "\n   calculated: " << y[i]);
+            }
+        }
+    }
+
+}
+
+void InterpolationTest::testBatchEvaluation() {
+    BOOST_TEST_MESSAGE("Testing batch evaluation of interpolations...");
+
+    std::vector<Real> knots, values;
+    for (Size i=0; i<20; ++i) {
+        knots.push_back(0.5*i + 0.01*i*i);
+        values.push_back(1.0 + 0.2*std::sin(0.7*i) + 0.03*i);
+    }
+
+    // sorted points, including knots and points outside the range
+    std::vector<Real> sorted;
+    for (Size i=0; i<=250; ++i)
+        sorted.push_back(-0.5 + 0.05*i);
+    sorted.insert(sorted.end(), knots.begin(), knots.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    // the same points in an order requiring backward jumps
+    std::vector<Real> unsorted;
+    for (Size i=0; i<sorted.size(); i+=2)
+        unsorted.push_back(sorted[sorted.size()-1-i]);
+    for (Size i=1; i<sorted.size(); i+=2)
+        unsorted.push_back(sorted[i]);
+
+    std::vector<std::pair<std::string, Interpolation> > interpolations;
+    interpolations.push_back(std::make_pair(std::string("linear"),
+        Linear().interpolate(knots.begin(), knots.end(), values.begin())));
+    interpolations.push_back(std::make_pair(std::string("log-linear"),
+        LogLinear().interpolate(knots.begin(), knots.end(),
+                                values.begin())));
+    interpolations.push_back(std::make_pair(std::string("cubic"),
+        Cubic(CubicInterpolation::Spline, true).interpolate(
+                            knots.begin(), knots.end(), values.begin())));
+    interpolations.push_back(std::make_pair(std::string("backward-flat"),
+        BackwardFlat().interpolate(knots.begin(), knots.end(),
+                                   values.begin())));
+    interpolations.push_back(std::make_pair(std::string("forward-flat"),
+        ForwardFlat().interpolate(knots.begin(), knots.end(),
+                                  values.begin())));
+    interpolations.push_back(std::make_pair(std::string("convex-monotone"),
+        ConvexMonotone().interpolate(knots.begin(), knots.end(),
+                                     values.begin())));
+
+    for (Size i=0; i<interpolations.size(); ++i) {
+        checkBatchEvaluation(interpolations[i].first,
+                             interpolations[i].second, sorted);
+        checkBatchEvaluation(interpolations[i].first,
+                             interpolations[i].second, unsorted);
+    }
+}
+
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2497,6 +2570,7 @@ test_suite* InterpolationTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testBackwardFlatOnSinglePoint));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBatchEvaluation));
 
 
     return suite;
@@ -62,6 +62,7 @@ class InterpolationTest {
     static void testLagrangeInterpolationOnChebyshevPoints();
     static void testBSplines();
     static void testBackwardFlatOnSinglePoint();
+    static void testBatchEvaluation();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -25,6 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "marketmodel.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
@@ -38,10 +39,12 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerbatch.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerconstrained.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -62,6 +65,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/products/onestep/onestepforwards.hpp>
 #include <ql/models/marketmodels/products/onestep/onestepoptionlets.hpp>
 #include <ql/models/marketmodels/forwardforwardmappings.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/proxygreekengine.hpp>
 #include <ql/models/marketmodels/swapforwardmappings.hpp>
 #include <ql/models/marketmodels/models/fwdperiodadapter.hpp>
@@ -3033,6 +3037,12 @@ void MarketModelTest::testPathwiseVegas()
 
                 Size numberFailures=0;
                 Size numberFailures2=0;
+                Size numberFailures3=0;
+
+                std::vector<Real> rateSensitivities(evolution.numberOfRates());
+                for (Size i=0; i < rateSensitivities.size(); ++i)
+                    rateSensitivities[i] = 1.0/(1.0+i);
+                Matrix adjointVegas(evolution.numberOfRates(), factors);
 
                 for (Size l=0; l < pathsToDo; ++l)
                 {
@@ -3092,6 +3102,26 @@ void MarketModelTest::testPathwiseVegas()
                             }
                         }
 
+                        // the adjoint version must give the contraction of the full jacobian
+                        testees2[currentStep].getVegas(oldRates, oneStepDFs, newRates, gaussians, rateSensitivities, adjointVegas);
+
+                        for (Size k1=0; k1 < numberRates; ++k1)
+                            for (Size f1=0; f1 < factors; ++f1)
+                            {
+                                Real sum =0.0;
+                                for (Size j1=0; j1 < numberRates; ++j1)
+                                    sum += rateSensitivities[j1]*globalB[j1][k1][f1];
+
+                                if (fabs(adjointVegas[k1][f1]-sum) > 1.0e-12*std::max(1.0, fabs(sum)))
+                                {
+                                    ++numberFailures3;
+                                    if (printReport_)
+                                        BOOST_TEST_MESSAGE("path " << l << " step "
+                                        << currentStep << " k " << k1
+                                        << " f " << f1 << " adjoint " << adjointVegas[k1][f1] << "  contracted " << sum);
+                                }
+                            }
+
 
 
                         for (Size j=0; j < B.rows(); ++j)
@@ -3138,6 +3168,9 @@ void MarketModelTest::testPathwiseVegas()
                 
                 if (numberFailures2 >0)
                     BOOST_FAIL("Pathwise rate pseudoroot jacobian all elements test fails : " << numberFailures2 <<"\n");
+
+                if (numberFailures3 >0)
+                    BOOST_FAIL("Pathwise rate pseudoroot jacobian adjoint test fails : " << numberFailures3 <<"\n");
             } // end of k loop over measures
 
 
@@ -4731,6 +4764,209 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testBatchEvolvers() {
+
+    BOOST_TEST_MESSAGE("Testing batch evolvers against single-path ones...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    Real tolerance = 1.0e-12;
+    Size paths = 1000, batchSize = 300;
+
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    MeasureType measures[] = { MoneyMarket, Terminal };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        ext::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[m],
+                            ExponentialCorrelationAbcdVolatility);
+        for (Size k=0; k<LENGTH(measures); ++k) {
+            std::vector<Size> numeraires = makeMeasure(product, measures[k]);
+            Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+            // drifts for a batch of perturbed forwards
+            for (Size j=0; j<evolution.numberOfSteps(); ++j) {
+                LMMDriftCalculator calculator(
+                    marketModel->pseudoRoot(j), marketModel->displacements(),
+                    evolution.rateTaus(), numeraires[j],
+                    evolution.firstAliveRate()[j]);
+                Size n = todaysForwards.size(), batch = 5;
+                Matrix forwards(n, batch), batchDrifts(n, batch, 0.0);
+                for (Size i=0; i<n; ++i)
+                    for (Size p=0; p<batch; ++p)
+                        forwards[i][p] = todaysForwards[i]*(1.0+0.1*p);
+                calculator.compute(forwards, batchDrifts);
+                std::vector<Rate> f(n);
+                std::vector<Real> drifts(n, 0.0);
+                for (Size p=0; p<batch; ++p) {
+                    std::copy(forwards.column_begin(p),
+                              forwards.column_end(p), f.begin());
+                    calculator.compute(f, drifts);
+                    for (Size i=evolution.firstAliveRate()[j]; i<n; ++i) {
+                        if (std::fabs(drifts[i]-batchDrifts[i][p])
+                                                                > tolerance)
+                            BOOST_ERROR("batch drift mismatch at step " << j
+                                        << ", rate " << i << ", path " << p
+                                        << "\n    batch:  " << batchDrifts[i][p]
+                                        << "\n    single: " << drifts[i]);
+                    }
+                }
+            }
+
+            for (Size e=0; e<2; ++e) {
+                MTBrownianGeneratorFactory generatorFactory(seed_);
+                ext::shared_ptr<MarketModelEvolver> evolver;
+                ext::shared_ptr<MarketModelBatchEvolver> batchEvolver;
+                if (e == 0) {
+                    evolver = ext::make_shared<LogNormalFwdRatePc>(
+                                 marketModel, generatorFactory, numeraires);
+                    batchEvolver = ext::make_shared<LogNormalFwdRatePcBatch>(
+                                 marketModel, generatorFactory, numeraires);
+                } else {
+                    evolver = ext::make_shared<LogNormalFwdRateEuler>(
+                                 marketModel, generatorFactory, numeraires);
+                    batchEvolver =
+                        ext::make_shared<LogNormalFwdRateEulerBatch>(
+                                 marketModel, generatorFactory, numeraires);
+                }
+
+                SequenceStatisticsInc stats(product.numberOfProducts()),
+                                      batchStats(product.numberOfProducts());
+                AccountingEngine engine(evolver, product,
+                                        initialNumeraireValue);
+                engine.multiplePathValues(stats, paths);
+                BatchAccountingEngine batchEngine(batchEvolver, product,
+                                                  initialNumeraireValue,
+                                                  batchSize);
+                batchEngine.multiplePathValues(batchStats, paths);
+
+                std::vector<Real> means = stats.mean(),
+                                  batchMeans = batchStats.mean();
+                for (Size i=0; i<means.size(); ++i) {
+                    if (std::fabs(means[i]-batchMeans[i]) > tolerance)
+                        BOOST_ERROR("batch value mismatch for "
+                                    << (e == 0 ? "Pc" : "Euler")
+                                    << " evolver, " << testedFactors[m]
+                                    << " factors, "
+                                    << measureTypeToString(measures[k])
+                                    << ", " << io::ordinal(i+1)
+                                    << " product"
+                                    << "\n    batch:  " << batchMeans[i]
+                                    << "\n    single: " << means[i]);
+                }
+
+                // new paths must start from the state set by the user
+                std::vector<Rate> shiftedForwards(todaysForwards);
+                for (Size i=0; i<shiftedForwards.size(); ++i)
+                    shiftedForwards[i] += 0.01;
+                LMMCurveState cs(evolution.rateTimes());
+                cs.setOnForwardRates(shiftedForwards);
+                batchEvolver->setInitialState(cs);
+                batchEvolver->startNewPaths(3);
+                const Matrix& forwards = batchEvolver->currentForwards();
+                for (Size i=0; i<shiftedForwards.size(); ++i) {
+                    for (Size p=0; p<3; ++p) {
+                        if (std::fabs(forwards[i][p]-shiftedForwards[i])
+                                                                > tolerance)
+                            BOOST_ERROR("initial state ignored by "
+                                        << (e == 0 ? "Pc" : "Euler")
+                                        << " batch evolver for rate " << i
+                                        << "\n    forward:  " << forwards[i][p]
+                                        << "\n    expected: "
+                                        << shiftedForwards[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting engine...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+
+    Size streams = 4, paths = 1001;
+    Real tolerance = 1.0e-12;
+
+    // each stream uses its own generator
+    std::vector<ext::shared_ptr<AccountingEngine> > engines, blockEngines;
+    SequenceStatisticsInc expected(product.numberOfProducts());
+    for (Size i=0; i<streams; ++i) {
+        MTBrownianGeneratorFactory generatorFactory(seed_+i);
+        for (Size k=0; k<3; ++k) {
+            ext::shared_ptr<MarketModelEvolver> evolver =
+                ext::make_shared<LogNormalFwdRatePc>(marketModel,
+                                                     generatorFactory,
+                                                     numeraires);
+            ext::shared_ptr<AccountingEngine> engine =
+                ext::make_shared<AccountingEngine>(evolver, product,
+                                                   initialNumeraireValue);
+            if (k == 0)
+                engines.push_back(engine);
+            else if (k == 1)
+                blockEngines.push_back(engine);
+            else
+                engine->multiplePathValues(expected,
+                                           paths/streams + (i<paths%streams));
+        }
+    }
+
+    // one block per stream: same order as running the streams in turn
+    ParallelAccountingEngine<AccountingEngine> parallelEngine(engines, paths);
+    SequenceStatisticsInc stats(product.numberOfProducts());
+    parallelEngine.multiplePathValues(stats, paths);
+
+    // smaller blocks: same paths, interleaved
+    ParallelAccountingEngine<AccountingEngine> blockEngine(blockEngines, 50);
+    SequenceStatisticsInc blockStats(product.numberOfProducts());
+    blockEngine.multiplePathValues(blockStats, paths);
+
+    if (stats.samples() != paths || blockStats.samples() != paths)
+        BOOST_ERROR("wrong number of samples: " << stats.samples()
+                    << " and " << blockStats.samples()
+                    << " instead of " << paths);
+
+    std::vector<Real> expectedMeans = expected.mean(),
+                      means = stats.mean(), blockMeans = blockStats.mean(),
+                      expectedErrors = expected.errorEstimate(),
+                      errors = stats.errorEstimate();
+    for (Size i=0; i<expectedMeans.size(); ++i) {
+        if (means[i] != expectedMeans[i] || errors[i] != expectedErrors[i])
+            BOOST_ERROR("parallel results differ from sequential ones for "
+                        << io::ordinal(i+1) << " product:"
+                        << "\n    parallel mean:    " << means[i]
+                        << "\n    sequential mean:  " << expectedMeans[i]
+                        << "\n    parallel error:   " << errors[i]
+                        << "\n    sequential error: " << expectedErrors[i]);
+        if (std::fabs(blockMeans[i]-expectedMeans[i]) > tolerance)
+            BOOST_ERROR("block results differ from sequential ones for "
+                        << io::ordinal(i+1) << " product:"
+                        << "\n    block mean:      " << blockMeans[i]
+                        << "\n    sequential mean: " << expectedMeans[i]);
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4882,6 +5118,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBatchEvolvers));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccountingEngine));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
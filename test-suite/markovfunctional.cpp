@@ -50,6 +50,7 @@
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/models/shortrate/calibrationhelpers/caphelper.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1745,6 +1746,83 @@ void MarkovFunctionalTest::testBermudanSwaption() {
     Settings::instance().evaluationDate() = savedEvalDate;
 }
 
+void MarkovFunctionalTest::testIncrementalNumeraireUpdate() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Markov functional incremental numeraire update...");
+
+    const Real tol = 1E-12;
+
+    Date savedEvalDate = Settings::instance().evaluationDate();
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    Handle<YieldTermStructure> flatYts_ = flatYts();
+
+    std::vector<Period> optionTenors, swapTenors;
+    for (Size i = 1; i <= 15; i++)
+        optionTenors.push_back(i * Years);
+    swapTenors.push_back(1 * Years);
+    swapTenors.push_back(10 * Years);
+    swapTenors.push_back(20 * Years);
+
+    std::vector<std::vector<Handle<Quote> > > volQuotes(optionTenors.size());
+    std::vector<ext::shared_ptr<SimpleQuote> > bumpedQuotes;
+    for (Size i = 0; i < optionTenors.size(); i++) {
+        for (Size j = 0; j < swapTenors.size(); j++) {
+            ext::shared_ptr<SimpleQuote> q =
+                ext::make_shared<SimpleQuote>(0.20 - 0.005 * i);
+            volQuotes[i].push_back(Handle<Quote>(q));
+            if (i == 2)
+                bumpedQuotes.push_back(q);
+        }
+    }
+    Handle<SwaptionVolatilityStructure> swaptionVts(
+        ext::make_shared<SwaptionVolatilityMatrix>(
+            TARGET(), ModifiedFollowing, optionTenors, swapTenors, volQuotes,
+            Actual365Fixed(), true));
+
+    ext::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+
+    std::vector<Date> volStepDates;
+    std::vector<Real> vols(1, 1.0);
+
+    MarkovFunctional::ModelSettings settings =
+        MarkovFunctional::ModelSettings().withYGridPoints(32);
+
+    ext::shared_ptr<MarkovFunctional> mf(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, vols, swaptionVts,
+        expiriesCalBasket1(), tenorsCalBasket1(), swapIndexBase,
+        MarkovFunctional::ModelSettings(settings).addAdjustment(
+            MarkovFunctional::ModelSettings::IncrementalNumeraireUpdate)));
+
+    // trigger the initial calibration, then bump the 3y smile, so that
+    // only the numeraire up to the 4y expiry must be retabulated
+    mf->numeraire(1.0, 0.0);
+    for (Size j = 0; j < bumpedQuotes.size(); j++)
+        bumpedQuotes[j]->setValue(bumpedQuotes[j]->value() + 0.02);
+
+    ext::shared_ptr<MarkovFunctional> mfFull(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, vols, swaptionVts,
+        expiriesCalBasket1(), tenorsCalBasket1(), swapIndexBase, settings));
+
+    Time times[] = { 0.5, 1.0, 2.5, 3.5, 4.0, 5.0, 8.0, 12.0 };
+    for (Size i = 0; i < LENGTH(times); i++) {
+        for (Real y = -3.0; y <= 3.0; y += 0.5) {
+            Real incremental = mf->numeraire(times[i], y);
+            Real full = mfFull->numeraire(times[i], y);
+            if (fabs(incremental - full) > tol * full)
+                BOOST_ERROR("numeraire after incremental update ("
+                            << incremental
+                            << ") differs from full recalibration (" << full
+                            << ") at t=" << times[i] << ", y=" << y);
+        }
+    }
+
+    Settings::instance().evaluationDate() = savedEvalDate;
+}
+
 test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
     test_suite *suite = BOOST_TEST_SUITE("Markov functional model tests");
 
@@ -1759,6 +1837,8 @@ test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
             &MarkovFunctionalTest::testCalibrationOneInstrumentSet));
         suite->add(QUANTLIB_TEST_CASE(
             &MarkovFunctionalTest::testCalibrationTwoInstrumentSets));
+        suite->add(QUANTLIB_TEST_CASE(
+            &MarkovFunctionalTest::testIncrementalNumeraireUpdate));
     }
 
     if (speed == Slow) {
@@ -34,6 +34,7 @@ class MarkovFunctionalTest {
     static void testCalibrationTwoInstrumentSets();
     static void testVanillaEngines();
     static void testBermudanSwaption();
+    static void testIncrementalNumeraireUpdate();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -736,6 +736,66 @@ void MatricesTest::testInitializers() {
     BOOST_CHECK_EQUAL(m3(1, 1), 4.0);
 }
 
+void MatricesTest::testMultiplication() {
+    BOOST_TEST_MESSAGE("Testing matrix multiplication...");
+
+    MersenneTwisterUniformRng rng(1234);
+
+    // sizes not multiple of the block size used by the fallback
+    const Size sizes[][3] = { {1, 1, 1}, {3, 5, 2}, {70, 130, 90},
+                              {129, 65, 1}, {1, 200, 67} };
+
+    for (Size n=0; n<LENGTH(sizes); ++n) {
+        const Size rows = sizes[n][0], inner = sizes[n][1],
+                   columns = sizes[n][2];
+        Matrix a(rows, inner), b(inner, columns);
+        for (Matrix::iterator i = a.begin(); i != a.end(); ++i)
+            *i = rng.next().value - 0.5;
+        for (Matrix::iterator i = b.begin(); i != b.end(); ++i)
+            *i = rng.next().value - 0.5;
+        Array x(inner), y(rows);
+        for (Size k=0; k<inner; ++k)
+            x[k] = rng.next().value - 0.5;
+        for (Size i=0; i<rows; ++i)
+            y[i] = rng.next().value - 0.5;
+
+        const Matrix c = a*b;
+        const Array ax = a*x, ya = y*a;
+        const Real tol = 1e-13;
+
+        for (Size i=0; i<rows; ++i) {
+            for (Size j=0; j<columns; ++j) {
+                Real expected = 0.0;
+                for (Size k=0; k<inner; ++k)
+                    expected += a[i][k]*b[k][j];
+                if (std::fabs(c[i][j]-expected) > tol)
+                    BOOST_FAIL("matrix product failed for "
+                               << rows << "x" << inner << " times "
+                               << inner << "x" << columns << " matrices"
+                               << "\n element:    (" << i << ", " << j << ")"
+                               << "\n calculated: " << c[i][j]
+                               << "\n expected:   " << expected);
+            }
+            Real expected = 0.0;
+            for (Size k=0; k<inner; ++k)
+                expected += a[i][k]*x[k];
+            if (std::fabs(ax[i]-expected) > tol)
+                BOOST_FAIL("matrix-vector product failed"
+                           << "\n calculated: " << ax[i]
+                           << "\n expected:   " << expected);
+        }
+        for (Size k=0; k<inner; ++k) {
+            Real expected = 0.0;
+            for (Size i=0; i<rows; ++i)
+                expected += y[i]*a[i][k];
+            if (std::fabs(ya[k]-expected) > tol)
+                BOOST_FAIL("vector-matrix product failed"
+                           << "\n calculated: " << ya[k]
+                           << "\n expected:   " << expected);
+        }
+    }
+}
+
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
@@ -754,6 +814,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testIterativeSolvers));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInitializers));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMultiplication));
     return suite;
 }
 
@@ -42,6 +42,7 @@ class MatricesTest {
     static void testMoorePenroseInverse();
     static void testIterativeSolvers();
     static void testInitializers();
+    static void testMultiplication();
     static boost::unit_test_framework::test_suite* suite();
 };
 
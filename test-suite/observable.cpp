@@ -27,6 +27,9 @@
 #include <ql/termstructures/volatility/optionlet/strippedoptionlet.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#ifdef QL_ENABLE_THREAD_LOCAL_SETTINGS
+#include <thread>
+#endif
 
 
 using namespace QuantLib;
@@ -306,6 +309,98 @@ void ObservableTest::testDeepUpdate() {
     BOOST_CHECK_CLOSE(v4, 0.21, 1E-10);
 }
 
+#if !defined(QL_ENABLE_SESSIONS)
+
+namespace {
+
+    struct LocalSettingsWorker {
+        Date evaluationDate, insideDate, outsideDate;
+        Real initialDiscount, discountAfterChange;
+        void operator()() {
+            {
+                LocalSettings local;
+                Settings::instance().evaluationDate() = evaluationDate;
+                FlatForward curve(0, NullCalendar(), 0.05, Actual365Fixed());
+                initialDiscount = curve.discount(evaluationDate + 365);
+                // moving the local date one year forward shifts the curve
+                Settings::instance().evaluationDate() = evaluationDate + 365;
+                discountAfterChange = curve.discount(evaluationDate + 365);
+                insideDate = Settings::instance().evaluationDate();
+                // indexes register with the shared fixing history
+                Euribor6M index;
+            }
+            outsideDate = Settings::instance().evaluationDate();
+        }
+    };
+
+    void checkLocalSettings(const LocalSettingsWorker& w, const Date& today,
+                            const std::string& thread) {
+        Real expected = std::exp(-0.05);
+        if (w.insideDate != w.evaluationDate + 365)
+            BOOST_ERROR("local evaluation date not used in " << thread
+                        << "\n    expected: " << w.evaluationDate + 365
+                        << "\n    found:    " << w.insideDate);
+        if (w.outsideDate != today)
+            BOOST_ERROR("global evaluation date not restored in " << thread
+                        << "\n    expected: " << today
+                        << "\n    found:    " << w.outsideDate);
+        if (std::fabs(w.initialDiscount - expected) > 1.0e-12)
+            BOOST_ERROR("curve not built on local evaluation date in "
+                        << thread
+                        << "\n    expected discount: " << expected
+                        << "\n    calculated:        " << w.initialDiscount);
+        if (std::fabs(w.discountAfterChange - 1.0) > 1.0e-12)
+            BOOST_ERROR("curve not moved with local evaluation date in "
+                        << thread
+                        << "\n    expected discount: " << 1.0
+                        << "\n    calculated:        "
+                        << w.discountAfterChange);
+    }
+
+}
+
+void ObservableTest::testLocalSettings() {
+
+    BOOST_TEST_MESSAGE("Testing local settings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today = Date(15, March, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    LocalSettingsWorker worker;
+    worker.evaluationDate = today + 20;
+    worker();
+    checkLocalSettings(worker, today, "calling thread");
+
+    #ifdef QL_ENABLE_THREAD_LOCAL_SETTINGS
+    std::vector<LocalSettingsWorker> workers(4);
+    for (Size i=0; i<workers.size(); ++i)
+        workers[i].evaluationDate = today + Integer(30*(i+1));
+
+    std::vector<std::thread> threads;
+    for (Size i=0; i<workers.size(); ++i)
+        threads.push_back(std::thread(std::ref(workers[i])));
+    for (Size i=0; i<threads.size(); ++i)
+        threads[i].join();
+
+    for (Size i=0; i<workers.size(); ++i) {
+        std::ostringstream thread;
+        thread << "thread " << i;
+        checkLocalSettings(workers[i], today, thread.str());
+    }
+    #endif
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("global evaluation date modified by local settings"
+                    << "\n    expected: " << today
+                    << "\n    found:    "
+                    << Settings::instance().evaluationDate());
+}
+
+#endif
+
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
@@ -319,6 +414,10 @@ test_suite* ObservableTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDeepUpdate));
 
+#if !defined(QL_ENABLE_SESSIONS)
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testLocalSettings));
+#endif
+
     return suite;
 }
 
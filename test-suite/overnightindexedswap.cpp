@@ -35,6 +35,7 @@
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
@@ -174,6 +175,40 @@ namespace {
         }
     };
 
+
+    Rate expectedCouponRate(const OvernightIndexedCoupon& coupon,
+                            const Handle<YieldTermStructure>& curve) {
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        const TimeSeries<Real>& history = coupon.index()->timeSeries();
+        Date today = Settings::instance().evaluationDate();
+        Real factor = 1.0;
+        Size i = 0;
+        while (i < dt.size() && fixingDates[i] <= today &&
+               history[fixingDates[i]] != Null<Real>()) {
+            factor *= 1.0 + history[fixingDates[i]]*dt[i];
+            ++i;
+        }
+        if (i < dt.size())
+            factor *= curve->discount(valueDates[i]) /
+                      curve->discount(valueDates.back());
+        return (factor - 1.0) / coupon.accrualPeriod();
+    }
+
+    void checkCouponRate(const OvernightIndexedCoupon& coupon,
+                         const Handle<YieldTermStructure>& curve,
+                         const std::string& what) {
+        Real tolerance = 1.0e-12;
+        Rate calculated = coupon.rate();
+        Rate expected = expectedCouponRate(coupon, curve);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce coupon rate " << what
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
 }
 
 
@@ -428,6 +463,64 @@ void OvernightIndexedSwapTest::testSeasonedSwaps() {
 }
 
 
+void OvernightIndexedSwapTest::testSeasonedCoupons() {
+
+    BOOST_TEST_MESSAGE("Testing cached compounding of past overnight fixings...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+
+    Date start = Date(1, February, 2006);
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = start - 1*Years; d < vars.today; ++d) {
+        if (vars.eoniaIndex->isValidFixingDate(d)) {
+            dates.push_back(d);
+            values.push_back(0.02 + 0.01*std::sin(0.01*values.size()));
+        }
+    }
+    vars.eoniaIndex->clearFixings();
+    vars.eoniaIndex->addFixings(dates.begin(), dates.end(), values.begin());
+
+    OvernightIndexedCoupon coupon(Date(3, August, 2009), 1.0,
+                                  start, Date(3, August, 2009),
+                                  vars.eoniaIndex);
+    OvernightIndexedCoupon telescopic(Date(3, August, 2009), 1.0,
+                                      vars.calendar.advance(vars.today, -3, Days),
+                                      Date(3, August, 2009),
+                                      vars.eoniaIndex,
+                                      1.0, 0.0, Date(), Date(),
+                                      DayCounter(), true);
+
+    Handle<YieldTermStructure> curve = vars.eoniaTermStructure;
+
+    checkCouponRate(coupon, curve, "with past fixings");
+    checkCouponRate(telescopic, curve, "with past fixings");
+
+    vars.eoniaIndex->addFixing(vars.today, 0.05);
+    checkCouponRate(coupon, curve, "after adding today's fixing");
+    checkCouponRate(telescopic, curve, "after adding today's fixing");
+
+    vars.eoniaIndex->addFixing(dates[dates.size()-2], 0.07, true);
+    checkCouponRate(coupon, curve, "after overwriting a past fixing");
+    checkCouponRate(telescopic, curve, "after overwriting a past fixing");
+
+    // move past the front stub of the telescopic value dates
+    Date later = vars.calendar.advance(vars.today, 15, Days);
+    for (Date d = vars.today + 1; d < later; ++d) {
+        if (vars.eoniaIndex->isValidFixingDate(d))
+            vars.eoniaIndex->addFixing(d, 0.03);
+    }
+    Settings::instance().evaluationDate() = later;
+    vars.eoniaTermStructure.linkTo(flatRate(later, 0.05, Actual365Fixed()));
+    checkCouponRate(coupon, curve, "after moving the evaluation date");
+    checkCouponRate(telescopic, curve, "after moving the evaluation date");
+
+    vars.eoniaIndex->clearFixings();
+    BOOST_CHECK_THROW(coupon.rate(), Error);
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
@@ -437,5 +530,7 @@ test_suite* OvernightIndexedSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
         &OvernightIndexedSwapTest::testBootstrapWithTelescopicDates));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testSeasonedSwaps));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OvernightIndexedSwapTest::testSeasonedCoupons));
     return suite;
 }
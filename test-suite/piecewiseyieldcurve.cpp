@@ -20,6 +20,7 @@
 #include "piecewiseyieldcurve.hpp"
 #include "utilities.hpp"
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/experimental/termstructures/multicurvesensitivities.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -992,6 +993,64 @@ namespace {
         }
     }
 
+    template <class T, class I>
+    void testCurveSnapshot(CommonVars& vars,
+                           const I& interpolator = I()) {
+
+        ext::shared_ptr<PiecewiseYieldCurve<T,I> > curve =
+            ext::make_shared<PiecewiseYieldCurve<T,I> >(
+                vars.settlementDays, vars.calendar, vars.instruments,
+                Actual360(), 1.0e-12, interpolator);
+        curve->enableExtrapolation();
+
+        ext::shared_ptr<YieldTermStructure> snapshot = curve->snapshot();
+        Flag f;
+        f.registerWith(snapshot);
+
+        std::vector<Date> dates;
+        std::vector<DiscountFactor> discounts;
+        for (Size i=0; i<=60; ++i) {
+            dates.push_back(vars.settlement + i*6*Months);
+            discounts.push_back(curve->discount(dates.back()));
+        }
+
+        if (snapshot->referenceDate() != curve->referenceDate())
+            BOOST_ERROR("snapshot has different reference date"
+                        << "\n original: " << curve->referenceDate()
+                        << "\n snapshot: " << snapshot->referenceDate());
+
+        for (Size i=0; i<dates.size(); ++i) {
+            DiscountFactor d = snapshot->discount(dates[i]);
+            if (std::fabs(d - discounts[i]) > 1.0e-14)
+                BOOST_ERROR("failed to reproduce discount factor"
+                            << "\n date:       " << dates[i]
+                            << "\n expected:   " << discounts[i]
+                            << "\n calculated: " << d);
+        }
+
+        // changes of market data and evaluation date affect the
+        // original curve, but not the snapshot
+        for (Size i=0; i<vars.rates.size(); ++i)
+            vars.rates[i]->setValue(vars.rates[i]->value() + 0.001);
+        Settings::instance().evaluationDate() =
+            vars.calendar.advance(vars.today, 15, Days);
+
+        if (f.isUp())
+            BOOST_ERROR("snapshot notified of changes in original curve");
+        if (curve->referenceDate() == snapshot->referenceDate())
+            BOOST_ERROR("failed to move reference date of original curve");
+        for (Size i=0; i<dates.size(); ++i) {
+            DiscountFactor d = snapshot->discount(dates[i]);
+            if (std::fabs(d - discounts[i]) > 1.0e-14)
+                BOOST_ERROR("snapshot modified by changes in original curve"
+                            << "\n date:       " << dates[i]
+                            << "\n expected:   " << discounts[i]
+                            << "\n calculated: " << d);
+        }
+
+        Settings::instance().evaluationDate() = vars.today;
+    }
+
 }
 
 
@@ -1016,6 +1075,24 @@ void PiecewiseYieldCurveTest::testZeroCopy() {
     testCurveCopy<ZeroYield,Linear>(vars);
 }
 
+void PiecewiseYieldCurveTest::testSnapshot() {
+    BOOST_TEST_MESSAGE("Testing snapshots of piecewise yield curves...");
+
+    {
+        CommonVars vars;
+        testCurveSnapshot<Discount,LogLinear>(vars);
+    }
+    {
+        CommonVars vars;
+        testCurveSnapshot<ForwardRate,BackwardFlat>(vars);
+    }
+    {
+        CommonVars vars;
+        testCurveSnapshot<ZeroYield,Cubic>(
+                               vars, Cubic(CubicInterpolation::Spline, true));
+    }
+}
+
 void PiecewiseYieldCurveTest::testSwapRateHelperLastRelevantDate() {
     BOOST_TEST_MESSAGE("Testing SwapRateHelper last relevant date...");
 
@@ -1105,6 +1182,144 @@ void PiecewiseYieldCurveTest::testBadPreviousCurve() {
 }
 
 
+namespace {
+
+    std::vector<Real> curveNodes(
+            const std::vector<ext::shared_ptr<YieldTermStructure> >& curves) {
+        std::vector<Real> result;
+        for (Size c=0; c<curves.size(); ++c) {
+            const std::vector<Real>& data =
+                ext::dynamic_pointer_cast<
+                    PiecewiseYieldCurve<ZeroYield,Linear> >(curves[c])->data();
+            result.insert(result.end(), data.begin()+1, data.end());
+        }
+        return result;
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testMultiCurveSensitivities() {
+    BOOST_TEST_MESSAGE(
+        "Testing multi-curve sensitivities against quote shifts...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(22, June, 2017);
+    Settings::instance().evaluationDate() = today;
+    Calendar calendar = TARGET();
+
+    typedef PiecewiseYieldCurve<ZeroYield,Linear> curve_type;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+
+    // discounting curve: deposit and swaps against 3-months Euribor
+    std::vector<ext::shared_ptr<RateHelper> > discountHelpers;
+    quotes.push_back(ext::make_shared<SimpleQuote>(0.010));
+    discountHelpers.push_back(ext::make_shared<DepositRateHelper>(
+        Handle<Quote>(quotes.back()), 3*Months, 2, calendar,
+        ModifiedFollowing, true, Actual360()));
+    Integer discountTenors[] = { 1, 2, 3, 5, 7 };
+    for (Size i=0; i<LENGTH(discountTenors); ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.011 + 0.002*i));
+        discountHelpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(quotes.back()), discountTenors[i]*Years, calendar,
+            Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+            ext::make_shared<Euribor3M>()));
+    }
+    ext::shared_ptr<YieldTermStructure> discountCurve =
+        ext::make_shared<curve_type>(today, discountHelpers, Actual365Fixed());
+    Handle<YieldTermStructure> discountHandle(discountCurve);
+
+    // forwarding curve: swaps against 6-months Euribor, discounted
+    // on the other curve
+    std::vector<ext::shared_ptr<RateHelper> > forwardHelpers;
+    Integer forwardTenors[] = { 1, 2, 4, 6 };
+    for (Size i=0; i<LENGTH(forwardTenors); ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.013 + 0.002*i));
+        forwardHelpers.push_back(ext::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(quotes.back()),
+                               forwardTenors[i]*Years, calendar,
+                               Annual, Unadjusted,
+                               Thirty360(Thirty360::BondBasis),
+                               ext::make_shared<Euribor6M>(),
+                               Handle<Quote>(), 0*Days, discountHandle)));
+    }
+    ext::shared_ptr<YieldTermStructure> forwardCurve =
+        ext::make_shared<curve_type>(today, forwardHelpers, Actual365Fixed());
+
+    std::vector<ext::shared_ptr<YieldTermStructure> > curves;
+    curves.push_back(discountCurve);
+    curves.push_back(forwardCurve);
+
+    // reference: shift each quote and bootstrap the curves again
+    Real shift = 1.0e-4;
+    Size n = quotes.size();
+    Matrix expected(n, n);
+    for (Size j=0; j<n; ++j) {
+        Real q = quotes[j]->value();
+        quotes[j]->setValue(q + shift);
+        std::vector<Real> up = curveNodes(curves);
+        quotes[j]->setValue(q - shift);
+        std::vector<Real> down = curveNodes(curves);
+        quotes[j]->setValue(q);
+        for (Size i=0; i<n; ++i)
+            expected[j][i] = (up[i] - down[i])/(2.0*shift);
+    }
+
+    std::vector<Real> nodes = curveNodes(curves);
+    Date testDate = today + 3*Years;
+    DiscountFactor discount = discountCurve->discount(testDate);
+    Flag flag;
+    flag.registerWith(discountCurve);
+
+    std::map<std::string, Handle<YieldTermStructure> > curveMap;
+    curveMap["discount"] = discountHandle;
+    curveMap["forward"] = Handle<YieldTermStructure>(forwardCurve);
+    MultiCurveSensitivities sensitivities(curveMap);
+    Matrix calculated = sensitivities.sensitivities();
+
+    Real tolerance = 1.0e-6;
+    for (Size j=0; j<n; ++j) {
+        for (Size i=0; i<n; ++i) {
+            if (std::fabs(calculated[j][i] - expected[j][i]) > tolerance)
+                BOOST_ERROR("failed to reproduce sensitivity of node #"
+                            << i+1 << " to quote #" << j+1
+                            << std::setprecision(10)
+                            << "\n    calculated: " << calculated[j][i]
+                            << "\n    expected:   " << expected[j][i]);
+        }
+    }
+
+    Matrix inverse = sensitivities.inverseSensitivities() * calculated;
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            if (std::fabs(inverse[i][j] - (i == j ? 1.0 : 0.0)) > 1.0e-10)
+                BOOST_ERROR("inverse sensitivities are not the inverse "
+                            "of the sensitivities at (" << i << ", " << j
+                            << "): " << inverse[i][j]);
+        }
+    }
+
+    if (!flag.isUp())
+        BOOST_ERROR("observers not notified of the shifts of the nodes");
+
+    std::vector<Real> restored = curveNodes(curves);
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(restored[i] - nodes[i]) > 1.0e-12)
+            BOOST_ERROR("node #" << i+1 << " not restored"
+                        << std::setprecision(12)
+                        << "\n    original: " << nodes[i]
+                        << "\n    restored: " << restored[i]);
+    }
+    if (std::fabs(discountCurve->discount(testDate) - discount) > 1.0e-12)
+        BOOST_ERROR("discount not restored"
+                    << std::setprecision(12)
+                    << "\n    original: " << discount
+                    << "\n    restored: "
+                    << discountCurve->discount(testDate));
+}
+
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     test_suite* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1143,6 +1358,7 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testDiscountCopy));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testForwardCopy));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testZeroCopy));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testSnapshot));
 
     suite->add(QUANTLIB_TEST_CASE(
                &PiecewiseYieldCurveTest::testSwapRateHelperLastRelevantDate));
@@ -1153,5 +1369,8 @@ test_suite* PiecewiseYieldCurveTest::suite() {
                              &PiecewiseYieldCurveTest::testBadPreviousCurve));
     #endif
 
+    suite->add(QUANTLIB_TEST_CASE(
+                      &PiecewiseYieldCurveTest::testMultiCurveSensitivities));
+
     return suite;
 }
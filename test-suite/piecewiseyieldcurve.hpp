@@ -49,11 +49,14 @@ class PiecewiseYieldCurveTest {
     static void testDiscountCopy();
     static void testForwardCopy();
     static void testZeroCopy();
+    static void testSnapshot();
 
     static void testSwapRateHelperLastRelevantDate();
 
     static void testBadPreviousCurve();
 
+    static void testMultiCurveSensitivities();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
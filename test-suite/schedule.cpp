@@ -20,6 +20,7 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -550,6 +551,81 @@ void ScheduleTest::testTruncation() {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache cache;
+    Calendar calendar = TARGET();
+    Date effective(15, March, 2019), termination(20, June, 2022);
+
+    ext::shared_ptr<const Schedule> s1 =
+        cache.schedule(effective, termination, 6*Months, calendar,
+                       ModifiedFollowing, Unadjusted,
+                       DateGeneration::Backward, false);
+
+    std::vector<Date> expected(8);
+    expected[0] = Date(15, March, 2019);
+    expected[1] = Date(20, June, 2019);
+    expected[2] = Date(20, December, 2019);
+    expected[3] = Date(22, June, 2020);
+    expected[4] = Date(21, December, 2020);
+    expected[5] = Date(21, June, 2021);
+    expected[6] = Date(20, December, 2021);
+    expected[7] = Date(20, June, 2022);
+    check_dates(*s1, expected);
+    for (Size i=1; i<s1->size(); ++i) {
+        if (s1->isRegular(i) != (i != 1))
+            BOOST_ERROR("wrong regularity flag for period " << i);
+    }
+
+    ext::shared_ptr<const Schedule> s2 =
+        cache.schedule(effective, termination, 6*Months, calendar,
+                       ModifiedFollowing, Unadjusted,
+                       DateGeneration::Backward, false);
+    if (s2 != s1)
+        BOOST_ERROR("identical schedule not shared");
+
+    ext::shared_ptr<const Schedule> s3 =
+        cache.schedule(effective, termination, 6*Months, calendar,
+                       ModifiedFollowing, Unadjusted,
+                       DateGeneration::Forward, false);
+    if (s3 == s1)
+        BOOST_ERROR("schedule with different rule shared");
+    check_dates(*s3, Schedule(effective, termination, 6*Months, calendar,
+                              ModifiedFollowing, Unadjusted,
+                              DateGeneration::Forward, false).dates());
+
+    if (cache.size() != 2)
+        BOOST_ERROR("expected 2 cached schedules, found " << cache.size());
+
+    std::vector<Date> effectiveDates, terminationDates;
+    std::vector<Period> tenors;
+    for (Size i=0; i<30; ++i) {
+        effectiveDates.push_back(effective + Integer(i%3));
+        terminationDates.push_back(termination);
+        tenors.push_back(i%2 == 0 ? 6*Months : 3*Months);
+    }
+    std::vector<ext::shared_ptr<const Schedule> > schedules =
+        cache.schedules(effectiveDates, terminationDates, tenors, calendar,
+                        ModifiedFollowing, Unadjusted,
+                        DateGeneration::Backward, false);
+    for (Size i=0; i<schedules.size(); ++i) {
+        Schedule s(effectiveDates[i], terminationDates[i], tenors[i],
+                   calendar, ModifiedFollowing, Unadjusted,
+                   DateGeneration::Backward, false);
+        check_dates(*schedules[i], s.dates());
+    }
+
+    // one of the six combinations was already cached
+    if (cache.size() != 7)
+        BOOST_ERROR("expected 7 cached schedules, found " << cache.size());
+
+    cache.clear();
+    if (cache.size() != 0)
+        BOOST_ERROR("cache not cleared");
+}
+
+
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDailySchedule));
@@ -572,5 +648,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFirstDateOnMaturity));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testNextToLastDateOnStart));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testTruncation));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
@@ -42,6 +42,7 @@ class ScheduleTest {
     static void testFirstDateOnMaturity();
     static void testNextToLastDateOnStart();
     static void testTruncation();
+    static void testScheduleCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
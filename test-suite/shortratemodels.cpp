@@ -39,6 +39,7 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/discretizedasset.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -459,6 +460,84 @@ void ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor() {
     }
 }
 
+void ShortRateModelTest::testTreeRollback() {
+    BOOST_TEST_MESSAGE("Testing rollback on short-rate trees...");
+
+    SavedSettings backup;
+    const Date today = Settings::instance().evaluationDate();
+
+    const Handle<YieldTermStructure> rTS(
+        flatRate(today, 0.04, Actual365Fixed()));
+    const HullWhite model(rTS, 0.1, 0.01);
+
+    const Time maturity = 10.0;
+    const TimeGrid grid(maturity, 200);
+    const ext::shared_ptr<Lattice> lattice = model.tree(grid);
+    const ext::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        ext::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(lattice);
+    BOOST_REQUIRE(tree);
+
+    // the step using the contiguous branching data must reproduce
+    // the generic one going through the tree node by node
+    const Size i = 150;
+    Array values(tree->size(i+1));
+    for (Size j=0; j<values.size(); ++j)
+        values[j] = 1.0 + 0.01*j;
+    Array fast(tree->size(i)), generic(tree->size(i));
+    tree->stepback(i, values, fast);
+    tree->TreeLattice<OneFactorModel::ShortRateTree>::stepback(i, values,
+                                                               generic);
+    for (Size j=0; j<fast.size(); ++j) {
+        if (std::fabs(fast[j] - generic[j]) > 1.0e-14)
+            BOOST_ERROR("failed to reproduce generic rollback step"
+                        << "\n    node:       " << j
+                        << std::setprecision(16)
+                        << "\n    calculated: " << fast[j]
+                        << "\n    expected:   " << generic[j]);
+    }
+
+    // assets rolled back together must match assets rolled back
+    // one at a time
+    DiscretizedDiscountBond single, first, second;
+    single.initialize(lattice, maturity);
+    first.initialize(lattice, maturity);
+    second.initialize(lattice, maturity);
+    second.values() *= 2.0;
+    single.rollback(0.0);
+    std::vector<DiscretizedAsset*> assets;
+    assets.push_back(&first);
+    assets.push_back(&second);
+    lattice->rollback(assets, 0.0);
+
+    const Real expected = rTS->discount(maturity);
+    const Real tolerance = 1.0e-6;
+    if (std::fabs(single.presentValue() - expected) > tolerance)
+        BOOST_ERROR("failed to reproduce discount bond price"
+                    << "\n    calculated: " << single.presentValue()
+                    << "\n    expected:   " << expected);
+    if (first.presentValue() != single.presentValue() ||
+        second.presentValue() != 2.0*single.presentValue())
+        BOOST_ERROR("failed to reproduce single-asset rollback"
+                    << std::setprecision(16)
+                    << "\n    single:  " << single.presentValue()
+                    << "\n    first:   " << first.presentValue()
+                    << "\n    second:  " << second.presentValue());
+
+    // cached discount factors must be refreshed when the spread changes
+    const Spread spread = 0.005;
+    tree->setSpread(spread);
+    DiscretizedDiscountBond spreaded;
+    spreaded.initialize(lattice, maturity);
+    spreaded.rollback(0.0);
+    const Real expectedSpreaded =
+        single.presentValue()*std::exp(-spread*maturity);
+    if (std::fabs(spreaded.presentValue() - expectedSpreaded) > 1.0e-12)
+        BOOST_ERROR("failed to apply spread to cached discount factors"
+                    << std::setprecision(16)
+                    << "\n    calculated: " << spreaded.presentValue()
+                    << "\n    expected:   " << expectedSpreaded);
+}
+
 test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
 
@@ -468,6 +547,7 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     suite->add(QUANTLIB_TEST_CASE(
         &ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeRollback));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
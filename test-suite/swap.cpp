@@ -20,9 +20,13 @@
 #include "swap.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/vanillaswap.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
@@ -98,6 +102,32 @@ namespace {
         }
     };
 
+    // builds a new copy of the market and swaps at each call
+    void buildSwapPortfolio(std::vector<Handle<SimpleQuote> >& quotes,
+                            std::vector<ext::shared_ptr<Instrument> >& swaps) {
+        ext::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.04));
+        ext::shared_ptr<SimpleQuote> spread(new SimpleQuote(0.002));
+        Handle<YieldTermStructure> discountCurve(
+            ext::make_shared<FlatForward>(0, TARGET(), Handle<Quote>(rate),
+                                          Actual365Fixed()));
+        Handle<YieldTermStructure> forwardCurve(
+            ext::make_shared<ZeroSpreadedTermStructure>(
+                discountCurve, Handle<Quote>(spread)));
+        ext::shared_ptr<IborIndex> index(new Euribor6M(forwardCurve));
+
+        quotes.clear();
+        quotes.push_back(Handle<SimpleQuote>(rate));
+        quotes.push_back(Handle<SimpleQuote>(spread));
+        swaps.clear();
+        Integer lengths[] = { 2, 5, 10 };
+        for (Size i=0; i<LENGTH(lengths); ++i) {
+            ext::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(lengths[i]*Years, index, 0.045)
+                .withDiscountingTermStructure(discountCurve);
+            swaps.push_back(swap);
+        }
+    }
+
 }
 
 
@@ -322,6 +352,64 @@ void SwapTest::testCachedValue() {
 }
 
 
+void SwapTest::testScenarioSensitivities() {
+
+    BOOST_TEST_MESSAGE("Testing swap bucket sensitivities on portfolio "
+                       "copies against a single portfolio...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(17, June, 2002);
+
+    std::vector<Handle<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<Instrument> > swaps;
+    buildSwapPortfolio(quotes, swaps);
+    SensitivityPortfolioBuilder builder(&buildSwapPortfolio);
+
+    const Real tolerance = 1.0e-10;
+
+    std::vector<std::vector<Real> > scenarios(3, std::vector<Real>(2, 0.0));
+    scenarios[0][0] = 0.001;
+    scenarios[1][1] = -0.0005;
+    scenarios[2][0] = scenarios[2][1] = 0.001;
+    Matrix npvs = scenarioNPVs(quotes, swaps, scenarios);
+    Matrix copyNpvs = scenarioNPVs(builder, scenarios);
+    for (Size i=0; i<npvs.rows(); ++i) {
+        for (Size j=0; j<npvs.columns(); ++j) {
+            if (std::fabs(copyNpvs[i][j] - npvs[i][j]) > tolerance)
+                BOOST_ERROR("failed to reproduce NPV of swap #" << i+1
+                            << " in scenario #" << j+1
+                            << "\n    single portfolio: " << npvs[i][j]
+                            << "\n    copies:           " << copyNpvs[i][j]);
+        }
+    }
+
+    std::pair<Matrix, Matrix> sensitivities =
+        bucketSensitivities(quotes, swaps, 0.0001, Centered);
+    std::pair<Matrix, Matrix> copySensitivities =
+        bucketSensitivities(builder, 0.0001, Centered);
+    for (Size i=0; i<swaps.size(); ++i) {
+        // payer swaps gain value when rates go up
+        if (sensitivities.first[i][0] <= 0.0 ||
+            sensitivities.first[i][1] <= 0.0)
+            BOOST_ERROR("wrong sign of delta for swap #" << i+1);
+        for (Size j=0; j<quotes.size(); ++j) {
+            if (std::fabs(copySensitivities.first[i][j]
+                          - sensitivities.first[i][j]) > tolerance ||
+                std::fabs(copySensitivities.second[i][j]
+                          - sensitivities.second[i][j]) > tolerance)
+                BOOST_ERROR("failed to reproduce sensitivities of swap #"
+                            << i+1 << " to quote #" << j+1
+                            << "\n    single portfolio: "
+                            << sensitivities.first[i][j] << ", "
+                            << sensitivities.second[i][j]
+                            << "\n    copies:           "
+                            << copySensitivities.first[i][j] << ", "
+                            << copySensitivities.second[i][j]);
+        }
+    }
+}
+
+
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
@@ -330,6 +418,7 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testScenarioSensitivities));
     return suite;
 }
 
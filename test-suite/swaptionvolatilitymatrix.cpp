@@ -370,6 +370,53 @@ void SwaptionVolatilityMatrixTest::testSwaptionVolMatrixCoherence() {
     vars.makeCoherenceTest(description, vol);
 }
 
+void SwaptionVolatilityMatrixTest::testSwaptionVolMatrixSnapshot() {
+
+    BOOST_TEST_MESSAGE("Testing swaption volatility matrix snapshot...");
+
+    CommonVars vars;
+
+    ext::shared_ptr<SwaptionVolatilityMatrix> vol =
+        ext::make_shared<SwaptionVolatilityMatrix>(vars.conventions.calendar,
+                                 vars.conventions.optionBdc,
+                                 vars.atm.tenors.options,
+                                 vars.atm.tenors.swaps,
+                                 vars.atm.volsHandle,
+                                 vars.conventions.dayCounter);
+    ext::shared_ptr<SwaptionVolatilityStructure> snapshot = vol->snapshot();
+
+    Rate dummyStrike = 0.02;
+    for (Size i=0; i<vars.atm.tenors.options.size(); ++i) {
+        for (Size j=0; j<vars.atm.tenors.swaps.size(); ++j) {
+            Volatility expected =
+                vol->volatility(vars.atm.tenors.options[i],
+                                vars.atm.tenors.swaps[j], dummyStrike);
+            Volatility calculated =
+                snapshot->volatility(vars.atm.tenors.options[i],
+                                     vars.atm.tenors.swaps[j], dummyStrike);
+            if (std::fabs(expected - calculated) > 1.0e-15)
+                BOOST_ERROR("failed to reproduce volatility in snapshot"
+                            << "\n option tenor: " << vars.atm.tenors.options[i]
+                            << "\n swap tenor:   " << vars.atm.tenors.swaps[j]
+                            << "\n expected:     " << expected
+                            << "\n calculated:   " << calculated);
+        }
+    }
+
+    vars.makeObservabilityTest("snapshot", snapshot, false, false);
+
+    Volatility initialVol =
+        snapshot->volatility(vars.atm.tenors.options[0],
+                             vars.atm.tenors.swaps[0], dummyStrike);
+    ext::dynamic_pointer_cast<SimpleQuote>(
+                   vars.atm.volsHandle[0][0].currentLink())->setValue(10);
+    Volatility newVol =
+        snapshot->volatility(vars.atm.tenors.options[0],
+                             vars.atm.tenors.swaps[0], dummyStrike);
+    if (initialVol != newVol)
+        BOOST_ERROR("snapshot volatility changed with market data");
+}
+
 test_suite* SwaptionVolatilityMatrixTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Matrix tests");
 
@@ -379,5 +426,8 @@ test_suite* SwaptionVolatilityMatrixTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
           &SwaptionVolatilityMatrixTest::testSwaptionVolMatrixObservability));
 
+    suite->add(QUANTLIB_TEST_CASE(
+              &SwaptionVolatilityMatrixTest::testSwaptionVolMatrixSnapshot));
+
     return suite;
 }
@@ -30,6 +30,7 @@ class SwaptionVolatilityMatrixTest {
   public:
     static void testSwaptionVolMatrixCoherence();
     static void testSwaptionVolMatrixObservability();
+    static void testSwaptionVolMatrixSnapshot();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -26,6 +26,9 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -461,6 +464,69 @@ void TermStructureTest::testCompositeZeroYieldStructures() {
     }
 }
 
+void TermStructureTest::testBatchDiscount() {
+    BOOST_TEST_MESSAGE("Testing batch calculation of discount factors...");
+
+    CommonVars vars;
+    Date today = Settings::instance().evaluationDate();
+
+    std::vector<Date> dates;
+    std::vector<DiscountFactor> discounts;
+    std::vector<Rate> zeros;
+    for (Size i=0; i<12; ++i) {
+        dates.push_back(today + (3*i*i + i)*Months);
+        Rate z = 0.01 + 0.002*i - 0.0001*i*i;
+        zeros.push_back(z);
+        discounts.push_back(std::exp(-z*(3*i*i + i)/12.0));
+    }
+    discounts[0] = 1.0;
+
+    std::vector<Handle<Quote> > jumps(1,
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.998)));
+    std::vector<Date> jumpDates(1, today + 2*Years);
+
+    std::vector<ext::shared_ptr<YieldTermStructure> > curves;
+    curves.push_back(ext::shared_ptr<YieldTermStructure>(
+        new DiscountCurve(dates, discounts, Actual365Fixed(), TARGET(),
+                          jumps, jumpDates)));
+    curves.push_back(ext::shared_ptr<YieldTermStructure>(
+        new ZeroCurve(dates, zeros, Actual365Fixed(), TARGET(),
+                      jumps, jumpDates)));
+    curves.push_back(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(today, 0.03, Actual365Fixed())));
+    // not yet bootstrapped
+    curves.push_back(vars.termStructure);
+
+    // sorted times, including times beyond the last node
+    std::vector<Time> times;
+    for (Size i=0; i<=400; ++i)
+        times.push_back(0.1*i);
+    // unsorted times
+    std::vector<Time> unsorted;
+    for (Size i=0; i<times.size(); i+=2)
+        unsorted.push_back(times[times.size()-1-i]);
+    for (Size i=1; i<times.size(); i+=2)
+        unsorted.push_back(times[i]);
+
+    for (Size k=0; k<curves.size(); ++k) {
+        for (Size j=0; j<2; ++j) {
+            const std::vector<Time>& t = (j == 0 ? times : unsorted);
+            std::vector<DiscountFactor> calculated =
+                curves[k]->discount(t, true);
+            for (Size i=0; i<t.size(); ++i) {
+                DiscountFactor expected = curves[k]->discount(t[i], true);
+                if (std::fabs(calculated[i] - expected) > 1.0e-14)
+                    BOOST_ERROR("unable to reproduce discount factor "
+                                "in batch calculation for curve #" << k+1
+                                << std::setprecision(16)
+                                << "\n    time:       " << t[i]
+                                << "\n    calculated: " << calculated[i]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -476,6 +542,7 @@ test_suite* TermStructureTest::suite() {
                              &TermStructureTest::testLinkToNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                     &TermStructureTest::testCompositeZeroYieldStructures));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchDiscount));
     return suite;
 }
 
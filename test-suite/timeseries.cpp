@@ -22,7 +22,15 @@
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
+#include <ql/indexes/fixingfile.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +201,196 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testFixingHistory() {
+
+    BOOST_TEST_MESSAGE("Testing dense storage of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Euribor6M index;
+    Calendar calendar = index.fixingCalendar();
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = Date(2, January, 2003); d < Date(2, January, 2013); ++d) {
+        if (calendar.isBusinessDay(d)) {
+            dates.push_back(d);
+            values.push_back(0.01 + 1.0e-6*values.size());
+        }
+    }
+
+    Flag flag;
+    flag.registerWith(IndexManager::instance().notifier(index.name()));
+
+    // load in reverse order to exercise extension at the front
+    index.addFixings(dates.rbegin(), dates.rend(), values.rbegin());
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of added fixings");
+
+    const FixingHistory& history = *index.fixingHistory();
+    if (history.size() != dates.size())
+        BOOST_ERROR("wrong number of stored fixings"
+                    << "\n    stored:   " << history.size()
+                    << "\n    expected: " << dates.size());
+    if (history.firstDate() != dates.front() ||
+        history.lastDate() != dates.back())
+        BOOST_ERROR("wrong range of stored fixings"
+                    << "\n    stored:   " << history.firstDate()
+                    << " to " << history.lastDate()
+                    << "\n    expected: " << dates.front()
+                    << " to " << dates.back());
+
+    const TimeSeries<Real>& series = index.timeSeries();
+    for (Size i=0; i<dates.size(); ++i) {
+        if (index.pastFixing(dates[i]) != values[i] ||
+            series[dates[i]] != values[i])
+            BOOST_FAIL("wrong fixing retrieved at " << dates[i]
+                       << "\n    stored:    " << index.pastFixing(dates[i])
+                       << "\n    in series: " << series[dates[i]]
+                       << "\n    expected:  " << values[i]);
+    }
+    if (history[Date(4, January, 2003)] != Null<Real>() ||
+        history[Date(1, January, 2003)] != Null<Real>() ||
+        history[Date(1, January, 2020)] != Null<Real>())
+        BOOST_ERROR("fixing retrieved at date without stored value");
+
+    // duplicated fixings are rejected unless forced
+    Date d = dates[10];
+    BOOST_CHECK_THROW(index.addFixing(d, 0.05), Error);
+    index.addFixing(d, 0.05, true);
+    if (index.pastFixing(d) != 0.05 || index.timeSeries()[d] != 0.05)
+        BOOST_ERROR("forced fixing not stored");
+
+    // ...also within a single batch
+    Date newDate = calendar.advance(dates.back(), 1, Days);
+    Date batchDates[] = { newDate, newDate };
+    Real conflicting[] = { 0.02, 0.03 };
+    Real repeated[] = { 0.02, 0.02 };
+    BOOST_CHECK_THROW(index.addFixings(batchDates, batchDates+2,
+                                       conflicting), Error);
+    index.clearFixings();
+    index.addFixings(batchDates, batchDates+2, repeated);
+    if (index.pastFixing(newDate) != 0.02 || history.size() != 1)
+        BOOST_ERROR("repeated fixing in batch not stored once");
+    index.addFixings(batchDates, batchDates+2, conflicting, true);
+    if (index.pastFixing(newDate) != 0.03 || history.size() != 1)
+        BOOST_ERROR("last forced fixing in batch not stored");
+
+    // clearing keeps the history registered with the index
+    flag.lower();
+    index.clearFixings();
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of cleared fixings");
+    if (!index.timeSeries().empty() || history.size() != 0 ||
+        IndexManager::instance().hasHistory(index.name()))
+        BOOST_ERROR("fixings not cleared");
+
+    flag.lower();
+    index.addFixing(d, 0.03);
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified after clearing fixings");
+    if (index.pastFixing(d) != 0.03 || history.size() != 1)
+        BOOST_ERROR("fixing not stored after clearing");
+}
+
+void TimeSeriesTest::testFixingFile() {
+
+    BOOST_TEST_MESSAGE("Testing fixing files...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Euribor6M euribor;
+    Eonia eonia;
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = Date(2, January, 2010); d < Date(2, January, 2012); ++d) {
+        if (euribor.isValidFixingDate(d)) {
+            dates.push_back(d);
+            values.push_back(0.02 + 1.0e-6*values.size());
+        }
+    }
+    euribor.addFixings(dates.begin(), dates.end(), values.begin());
+    eonia.addFixing(Date(15, March, 2011), 0.011);
+    eonia.addFixing(Date(17, March, 2011), 0.012);
+
+    std::string fileName = "quantlib-test-fixings.bin";
+    saveFixingFile(fileName);
+    IndexManager::instance().clearHistories();
+
+    Flag flag;
+    flag.registerWith(euribor.fixingHistory());
+
+    loadFixingFile(fileName);
+
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of loaded fixings");
+    if (euribor.fixingHistory()->size() != dates.size())
+        BOOST_ERROR("wrong number of loaded fixings"
+                    << "\n    loaded:   " << euribor.fixingHistory()->size()
+                    << "\n    expected: " << dates.size());
+    for (Size i=0; i<dates.size(); ++i) {
+        if (euribor.pastFixing(dates[i]) != values[i])
+            BOOST_FAIL("wrong fixing loaded at " << dates[i]
+                       << "\n    loaded:   " << euribor.pastFixing(dates[i])
+                       << "\n    expected: " << values[i]);
+    }
+    if (eonia.timeSeries().size() != 2 ||
+        eonia.pastFixing(Date(15, March, 2011)) != 0.011 ||
+        eonia.pastFixing(Date(16, March, 2011)) != Null<Real>() ||
+        eonia.pastFixing(Date(17, March, 2011)) != 0.012)
+        BOOST_ERROR("wrong fixings loaded for " << eonia.name());
+
+    // modifying loaded fixings doesn't require write access to the file
+    euribor.addFixing(Date(2, January, 2012), 0.03);
+    if (euribor.pastFixing(Date(2, January, 2012)) != 0.03 ||
+        euribor.pastFixing(dates.front()) != values.front() ||
+        euribor.fixingHistory()->size() != dates.size()+1)
+        BOOST_ERROR("failed to add fixing to loaded history");
+
+    IndexManager::instance().clearHistories();
+    std::remove(fileName.c_str());
+
+    BOOST_CHECK_THROW(loadFixingFile(fileName), Error);
+
+    // an entry claiming fixings but holding only null values is rejected
+    eonia.addFixing(Date(15, March, 2011), 0.011);
+    saveFixingFile(fileName);
+    IndexManager::instance().clearHistories();
+    std::string contents;
+    {
+        std::ifstream in(fileName.c_str(), std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in),
+                        std::istreambuf_iterator<char>());
+    }
+    // single entry after the 32-byte header; length and data offset
+    // are its fourth and sixth fields
+    boost::uint64_t length, dataOffset;
+    std::memcpy(&length, contents.data() + 32 + 24, sizeof(length));
+    std::memcpy(&dataOffset, contents.data() + 32 + 40, sizeof(dataOffset));
+    for (boost::uint64_t i=0; i<length; ++i) {
+        Real null = Null<Real>();
+        std::memcpy(&contents[dataOffset + i*sizeof(Real)], &null,
+                    sizeof(Real));
+    }
+    {
+        std::ofstream out(fileName.c_str(),
+                          std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), contents.size());
+    }
+    BOOST_CHECK_THROW(loadFixingFile(fileName), Error);
+    std::remove(fileName.c_str());
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingHistory));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingFile));
     return suite;
 }
 
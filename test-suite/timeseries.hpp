@@ -30,6 +30,8 @@ class TimeSeriesTest {
     static void testConstruction();
     static void testIntervalPrice();
     static void testIterators();
+    static void testFixingHistory();
+    static void testFixingFile();
     static boost::unit_test_framework::test_suite* suite();
     
 };